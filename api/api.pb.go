@@ -12,6 +12,12 @@
 		Request
 		Data
 		Response
+		Chunk
+		MultiGetRequest
+		MultiGetResponse
+		SetRequest
+		SetResponse
+		DropSetRequest
 */
 package api
 
@@ -62,11 +68,34 @@ func (x ShardStatus) String() string {
 }
 func (ShardStatus) EnumDescriptor() ([]byte, []int) { return fileDescriptorApi, []int{0} }
 
+type ScanProfile int32
+
+const (
+	ScanProfile_Interactive ScanProfile = 0
+	ScanProfile_Bulk        ScanProfile = 1
+)
+
+var ScanProfile_name = map[int32]string{
+	0: "Interactive",
+	1: "Bulk",
+}
+var ScanProfile_value = map[string]int32{
+	"Interactive": 0,
+	"Bulk":        1,
+}
+
+func (x ScanProfile) String() string {
+	return proto.EnumName(ScanProfile_name, int32(x))
+}
+func (ScanProfile) EnumDescriptor() ([]byte, []int) { return fileDescriptorApi, []int{1} }
+
 type Shard struct {
-	Path    string      `protobuf:"bytes,1,opt,name=path,proto3" json:"path,omitempty"`
-	Lastkey string      `protobuf:"bytes,2,opt,name=lastkey,proto3" json:"lastkey,omitempty"`
-	HasMore bool        `protobuf:"varint,3,opt,name=hasMore,proto3" json:"hasMore,omitempty"`
-	Status  ShardStatus `protobuf:"varint,4,opt,name=status,proto3,enum=api.ShardStatus" json:"status,omitempty"`
+	Path      string      `protobuf:"bytes,1,opt,name=path,proto3" json:"path,omitempty"`
+	Lastkey   []byte      `protobuf:"bytes,2,opt,name=lastkey,proto3" json:"lastkey,omitempty"`
+	HasMore   bool        `protobuf:"varint,3,opt,name=hasMore,proto3" json:"hasMore,omitempty"`
+	Status    ShardStatus `protobuf:"varint,4,opt,name=status,proto3,enum=api.ShardStatus" json:"status,omitempty"`
+	Cursor    uint64      `protobuf:"varint,5,opt,name=cursor,proto3" json:"cursor,omitempty"`
+	Lastrange uint32      `protobuf:"varint,6,opt,name=lastrange,proto3" json:"lastrange,omitempty"`
 }
 
 func (m *Shard) Reset()                    { *m = Shard{} }
@@ -81,11 +110,11 @@ func (m *Shard) GetPath() string {
 	return ""
 }
 
-func (m *Shard) GetLastkey() string {
+func (m *Shard) GetLastkey() []byte {
 	if m != nil {
 		return m.Lastkey
 	}
-	return ""
+	return nil
 }
 
 func (m *Shard) GetHasMore() bool {
@@ -102,12 +131,35 @@ func (m *Shard) GetStatus() ShardStatus {
 	return ShardStatus_Error
 }
 
+func (m *Shard) GetCursor() uint64 {
+	if m != nil {
+		return m.Cursor
+	}
+	return 0
+}
+
+func (m *Shard) GetLastrange() uint32 {
+	if m != nil {
+		return m.Lastrange
+	}
+	return 0
+}
+
 type Request struct {
-	UserId string   `protobuf:"bytes,1,opt,name=userId,proto3" json:"userId,omitempty"`
-	Query  string   `protobuf:"bytes,2,opt,name=query,proto3" json:"query,omitempty"`
-	Start  int64    `protobuf:"varint,3,opt,name=start,proto3" json:"start,omitempty"`
-	End    int64    `protobuf:"varint,4,opt,name=end,proto3" json:"end,omitempty"`
-	Shards []*Shard `protobuf:"bytes,5,rep,name=shards" json:"shards,omitempty"`
+	UserId     string      `protobuf:"bytes,1,opt,name=userId,proto3" json:"userId,omitempty"`
+	Query      string      `protobuf:"bytes,2,opt,name=query,proto3" json:"query,omitempty"`
+	Start      int64       `protobuf:"varint,3,opt,name=start,proto3" json:"start,omitempty"`
+	End        int64       `protobuf:"varint,4,opt,name=end,proto3" json:"end,omitempty"`
+	Shards     []*Shard    `protobuf:"bytes,5,rep,name=shards" json:"shards,omitempty"`
+	Profile    ScanProfile `protobuf:"varint,6,opt,name=profile,proto3,enum=api.ScanProfile" json:"profile,omitempty"`
+	LimitRows  uint32      `protobuf:"varint,7,opt,name=limitRows,proto3" json:"limitRows,omitempty"`
+	LimitBytes uint64      `protobuf:"varint,8,opt,name=limitBytes,proto3" json:"limitBytes,omitempty"`
+	TimeoutMs  uint32      `protobuf:"varint,9,opt,name=timeoutMs,proto3" json:"timeoutMs,omitempty"`
+	MaxKeys    uint64      `protobuf:"varint,10,opt,name=maxKeys,proto3" json:"maxKeys,omitempty"`
+	Reverse    bool        `protobuf:"varint,11,opt,name=reverse,proto3" json:"reverse,omitempty"`
+	UserIds    []string    `protobuf:"bytes,12,rep,name=userIds" json:"userIds,omitempty"`
+	Token      []byte      `protobuf:"bytes,13,opt,name=token,proto3" json:"token,omitempty"`
+	Compact    bool        `protobuf:"varint,14,opt,name=compact,proto3" json:"compact,omitempty"`
 }
 
 func (m *Request) Reset()                    { *m = Request{} }
@@ -150,6 +202,69 @@ func (m *Request) GetShards() []*Shard {
 	return nil
 }
 
+func (m *Request) GetProfile() ScanProfile {
+	if m != nil {
+		return m.Profile
+	}
+	return ScanProfile_Interactive
+}
+
+func (m *Request) GetLimitRows() uint32 {
+	if m != nil {
+		return m.LimitRows
+	}
+	return 0
+}
+
+func (m *Request) GetLimitBytes() uint64 {
+	if m != nil {
+		return m.LimitBytes
+	}
+	return 0
+}
+
+func (m *Request) GetTimeoutMs() uint32 {
+	if m != nil {
+		return m.TimeoutMs
+	}
+	return 0
+}
+
+func (m *Request) GetMaxKeys() uint64 {
+	if m != nil {
+		return m.MaxKeys
+	}
+	return 0
+}
+
+func (m *Request) GetReverse() bool {
+	if m != nil {
+		return m.Reverse
+	}
+	return false
+}
+
+func (m *Request) GetUserIds() []string {
+	if m != nil {
+		return m.UserIds
+	}
+	return nil
+}
+
+func (m *Request) GetToken() []byte {
+	if m != nil {
+		return m.Token
+	}
+	return nil
+}
+
+func (m *Request) GetCompact() bool {
+	if m != nil {
+		return m.Compact
+	}
+	return false
+}
+
 type Data struct {
 	Items []string `protobuf:"bytes,1,rep,name=items" json:"items,omitempty"`
 }
@@ -170,6 +285,7 @@ type Response struct {
 	Code   int32    `protobuf:"varint,1,opt,name=code,proto3" json:"code,omitempty"`
 	Shards []*Shard `protobuf:"bytes,2,rep,name=shards" json:"shards,omitempty"`
 	Data   []*Data  `protobuf:"bytes,3,rep,name=data" json:"data,omitempty"`
+	Token  []byte   `protobuf:"bytes,4,opt,name=token,proto3" json:"token,omitempty"`
 }
 
 func (m *Response) Reset()                    { *m = Response{} }
@@ -198,12 +314,194 @@ func (m *Response) GetData() []*Data {
 	return nil
 }
 
+func (m *Response) GetToken() []byte {
+	if m != nil {
+		return m.Token
+	}
+	return nil
+}
+
+type Chunk struct {
+	Code  int32  `protobuf:"varint,1,opt,name=code,proto3" json:"code,omitempty"`
+	Path  string `protobuf:"bytes,2,opt,name=path,proto3" json:"path,omitempty"`
+	Data  *Data  `protobuf:"bytes,3,opt,name=data" json:"data,omitempty"`
+	Token []byte `protobuf:"bytes,4,opt,name=token,proto3" json:"token,omitempty"`
+	Done  bool   `protobuf:"varint,5,opt,name=done,proto3" json:"done,omitempty"`
+}
+
+func (m *Chunk) Reset()                    { *m = Chunk{} }
+func (m *Chunk) String() string            { return proto.CompactTextString(m) }
+func (*Chunk) ProtoMessage()               {}
+func (*Chunk) Descriptor() ([]byte, []int) { return fileDescriptorApi, []int{4} }
+
+func (m *Chunk) GetCode() int32 {
+	if m != nil {
+		return m.Code
+	}
+	return 0
+}
+
+func (m *Chunk) GetPath() string {
+	if m != nil {
+		return m.Path
+	}
+	return ""
+}
+
+func (m *Chunk) GetData() *Data {
+	if m != nil {
+		return m.Data
+	}
+	return nil
+}
+
+func (m *Chunk) GetToken() []byte {
+	if m != nil {
+		return m.Token
+	}
+	return nil
+}
+
+func (m *Chunk) GetDone() bool {
+	if m != nil {
+		return m.Done
+	}
+	return false
+}
+
+type MultiGetRequest struct {
+	Keys    []string    `protobuf:"bytes,1,rep,name=keys" json:"keys,omitempty"`
+	Profile ScanProfile `protobuf:"varint,2,opt,name=profile,proto3,enum=api.ScanProfile" json:"profile,omitempty"`
+}
+
+func (m *MultiGetRequest) Reset()                    { *m = MultiGetRequest{} }
+func (m *MultiGetRequest) String() string            { return proto.CompactTextString(m) }
+func (*MultiGetRequest) ProtoMessage()               {}
+func (*MultiGetRequest) Descriptor() ([]byte, []int) { return fileDescriptorApi, []int{5} }
+
+func (m *MultiGetRequest) GetKeys() []string {
+	if m != nil {
+		return m.Keys
+	}
+	return nil
+}
+
+func (m *MultiGetRequest) GetProfile() ScanProfile {
+	if m != nil {
+		return m.Profile
+	}
+	return ScanProfile_Interactive
+}
+
+type MultiGetResponse struct {
+	Code   int32    `protobuf:"varint,1,opt,name=code,proto3" json:"code,omitempty"`
+	Values []string `protobuf:"bytes,2,rep,name=values" json:"values,omitempty"`
+	Found  []bool   `protobuf:"varint,3,rep,packed,name=found" json:"found,omitempty"`
+}
+
+func (m *MultiGetResponse) Reset()                    { *m = MultiGetResponse{} }
+func (m *MultiGetResponse) String() string            { return proto.CompactTextString(m) }
+func (*MultiGetResponse) ProtoMessage()               {}
+func (*MultiGetResponse) Descriptor() ([]byte, []int) { return fileDescriptorApi, []int{6} }
+
+func (m *MultiGetResponse) GetCode() int32 {
+	if m != nil {
+		return m.Code
+	}
+	return 0
+}
+
+func (m *MultiGetResponse) GetValues() []string {
+	if m != nil {
+		return m.Values
+	}
+	return nil
+}
+
+func (m *MultiGetResponse) GetFound() []bool {
+	if m != nil {
+		return m.Found
+	}
+	return nil
+}
+
+type SetRequest struct {
+	Values []string `protobuf:"bytes,1,rep,name=values" json:"values,omitempty"`
+	Ints   []int64  `protobuf:"varint,2,rep,packed,name=ints" json:"ints,omitempty"`
+}
+
+func (m *SetRequest) Reset()                    { *m = SetRequest{} }
+func (m *SetRequest) String() string            { return proto.CompactTextString(m) }
+func (*SetRequest) ProtoMessage()               {}
+func (*SetRequest) Descriptor() ([]byte, []int) { return fileDescriptorApi, []int{7} }
+
+func (m *SetRequest) GetValues() []string {
+	if m != nil {
+		return m.Values
+	}
+	return nil
+}
+
+func (m *SetRequest) GetInts() []int64 {
+	if m != nil {
+		return m.Ints
+	}
+	return nil
+}
+
+type SetResponse struct {
+	Code int32  `protobuf:"varint,1,opt,name=code,proto3" json:"code,omitempty"`
+	Set  uint64 `protobuf:"varint,2,opt,name=set,proto3" json:"set,omitempty"`
+}
+
+func (m *SetResponse) Reset()                    { *m = SetResponse{} }
+func (m *SetResponse) String() string            { return proto.CompactTextString(m) }
+func (*SetResponse) ProtoMessage()               {}
+func (*SetResponse) Descriptor() ([]byte, []int) { return fileDescriptorApi, []int{8} }
+
+func (m *SetResponse) GetCode() int32 {
+	if m != nil {
+		return m.Code
+	}
+	return 0
+}
+
+func (m *SetResponse) GetSet() uint64 {
+	if m != nil {
+		return m.Set
+	}
+	return 0
+}
+
+type DropSetRequest struct {
+	Set uint64 `protobuf:"varint,1,opt,name=set,proto3" json:"set,omitempty"`
+}
+
+func (m *DropSetRequest) Reset()                    { *m = DropSetRequest{} }
+func (m *DropSetRequest) String() string            { return proto.CompactTextString(m) }
+func (*DropSetRequest) ProtoMessage()               {}
+func (*DropSetRequest) Descriptor() ([]byte, []int) { return fileDescriptorApi, []int{9} }
+
+func (m *DropSetRequest) GetSet() uint64 {
+	if m != nil {
+		return m.Set
+	}
+	return 0
+}
+
 func init() {
 	proto.RegisterType((*Shard)(nil), "api.Shard")
 	proto.RegisterType((*Request)(nil), "api.Request")
 	proto.RegisterType((*Data)(nil), "api.Data")
 	proto.RegisterType((*Response)(nil), "api.Response")
+	proto.RegisterType((*Chunk)(nil), "api.Chunk")
+	proto.RegisterType((*MultiGetRequest)(nil), "api.MultiGetRequest")
+	proto.RegisterType((*MultiGetResponse)(nil), "api.MultiGetResponse")
+	proto.RegisterType((*SetRequest)(nil), "api.SetRequest")
+	proto.RegisterType((*SetResponse)(nil), "api.SetResponse")
+	proto.RegisterType((*DropSetRequest)(nil), "api.DropSetRequest")
 	proto.RegisterEnum("api.ShardStatus", ShardStatus_name, ShardStatus_value)
+	proto.RegisterEnum("api.ScanProfile", ScanProfile_name, ScanProfile_value)
 }
 
 // Reference imports to suppress errors if they are not otherwise used.
@@ -218,6 +516,10 @@ const _ = grpc.SupportPackageIsVersion4
 
 type DisgorgeServiceClient interface {
 	Query(ctx context.Context, in *Request, opts ...grpc.CallOption) (*Response, error)
+	QueryStream(ctx context.Context, in *Request, opts ...grpc.CallOption) (DisgorgeService_QueryStreamClient, error)
+	MultiGet(ctx context.Context, in *MultiGetRequest, opts ...grpc.CallOption) (*MultiGetResponse, error)
+	CreateSet(ctx context.Context, in *SetRequest, opts ...grpc.CallOption) (*SetResponse, error)
+	DropSet(ctx context.Context, in *DropSetRequest, opts ...grpc.CallOption) (*SetResponse, error)
 }
 
 type disgorgeServiceClient struct {
@@ -237,10 +539,73 @@ func (c *disgorgeServiceClient) Query(ctx context.Context, in *Request, opts ...
 	return out, nil
 }
 
+func (c *disgorgeServiceClient) QueryStream(ctx context.Context, in *Request, opts ...grpc.CallOption) (DisgorgeService_QueryStreamClient, error) {
+	stream, err := grpc.NewClientStream(ctx, &_DisgorgeService_serviceDesc.Streams[0], c.cc, "/api.DisgorgeService/QueryStream", opts...)
+	if err != nil {
+		return nil, err
+	}
+	x := &disgorgeServiceQueryStreamClient{stream}
+	if err := x.ClientStream.SendMsg(in); err != nil {
+		return nil, err
+	}
+	if err := x.ClientStream.CloseSend(); err != nil {
+		return nil, err
+	}
+	return x, nil
+}
+
+type DisgorgeService_QueryStreamClient interface {
+	Recv() (*Chunk, error)
+	grpc.ClientStream
+}
+
+type disgorgeServiceQueryStreamClient struct {
+	grpc.ClientStream
+}
+
+func (x *disgorgeServiceQueryStreamClient) Recv() (*Chunk, error) {
+	m := new(Chunk)
+	if err := x.ClientStream.RecvMsg(m); err != nil {
+		return nil, err
+	}
+	return m, nil
+}
+
+func (c *disgorgeServiceClient) MultiGet(ctx context.Context, in *MultiGetRequest, opts ...grpc.CallOption) (*MultiGetResponse, error) {
+	out := new(MultiGetResponse)
+	err := grpc.Invoke(ctx, "/api.DisgorgeService/MultiGet", in, out, c.cc, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *disgorgeServiceClient) CreateSet(ctx context.Context, in *SetRequest, opts ...grpc.CallOption) (*SetResponse, error) {
+	out := new(SetResponse)
+	err := grpc.Invoke(ctx, "/api.DisgorgeService/CreateSet", in, out, c.cc, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *disgorgeServiceClient) DropSet(ctx context.Context, in *DropSetRequest, opts ...grpc.CallOption) (*SetResponse, error) {
+	out := new(SetResponse)
+	err := grpc.Invoke(ctx, "/api.DisgorgeService/DropSet", in, out, c.cc, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
 // Server API for DisgorgeService service
 
 type DisgorgeServiceServer interface {
 	Query(context.Context, *Request) (*Response, error)
+	QueryStream(*Request, DisgorgeService_QueryStreamServer) error
+	MultiGet(context.Context, *MultiGetRequest) (*MultiGetResponse, error)
+	CreateSet(context.Context, *SetRequest) (*SetResponse, error)
+	DropSet(context.Context, *DropSetRequest) (*SetResponse, error)
 }
 
 func RegisterDisgorgeServiceServer(s *grpc.Server, srv DisgorgeServiceServer) {
@@ -265,49 +630,142 @@ func _DisgorgeService_Query_Handler(srv interface{}, ctx context.Context, dec fu
 	return interceptor(ctx, in, info, handler)
 }
 
-var _DisgorgeService_serviceDesc = grpc.ServiceDesc{
-	ServiceName: "api.DisgorgeService",
-	HandlerType: (*DisgorgeServiceServer)(nil),
-	Methods: []grpc.MethodDesc{
-		{
-			MethodName: "Query",
-			Handler:    _DisgorgeService_Query_Handler,
-		},
-	},
-	Streams:  []grpc.StreamDesc{},
-	Metadata: "api.proto",
+func _DisgorgeService_QueryStream_Handler(srv interface{}, stream grpc.ServerStream) error {
+	m := new(Request)
+	if err := stream.RecvMsg(m); err != nil {
+		return err
+	}
+	return srv.(DisgorgeServiceServer).QueryStream(m, &disgorgeServiceQueryStreamServer{stream})
 }
 
-func (m *Shard) Marshal() (dAtA []byte, err error) {
-	size := m.Size()
-	dAtA = make([]byte, size)
-	n, err := m.MarshalTo(dAtA)
-	if err != nil {
+type DisgorgeService_QueryStreamServer interface {
+	Send(*Chunk) error
+	grpc.ServerStream
+}
+
+type disgorgeServiceQueryStreamServer struct {
+	grpc.ServerStream
+}
+
+func (x *disgorgeServiceQueryStreamServer) Send(m *Chunk) error {
+	return x.ServerStream.SendMsg(m)
+}
+
+func _DisgorgeService_MultiGet_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(MultiGetRequest)
+	if err := dec(in); err != nil {
 		return nil, err
 	}
-	return dAtA[:n], nil
+	if interceptor == nil {
+		return srv.(DisgorgeServiceServer).MultiGet(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.DisgorgeService/MultiGet",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(DisgorgeServiceServer).MultiGet(ctx, req.(*MultiGetRequest))
+	}
+	return interceptor(ctx, in, info, handler)
 }
 
-func (m *Shard) MarshalTo(dAtA []byte) (int, error) {
-	var i int
-	_ = i
-	var l int
-	_ = l
-	if len(m.Path) > 0 {
-		dAtA[i] = 0xa
-		i++
-		i = encodeVarintApi(dAtA, i, uint64(len(m.Path)))
-		i += copy(dAtA[i:], m.Path)
+func _DisgorgeService_CreateSet_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(SetRequest)
+	if err := dec(in); err != nil {
+		return nil, err
 	}
-	if len(m.Lastkey) > 0 {
-		dAtA[i] = 0x12
-		i++
-		i = encodeVarintApi(dAtA, i, uint64(len(m.Lastkey)))
-		i += copy(dAtA[i:], m.Lastkey)
+	if interceptor == nil {
+		return srv.(DisgorgeServiceServer).CreateSet(ctx, in)
 	}
-	if m.HasMore {
-		dAtA[i] = 0x18
-		i++
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.DisgorgeService/CreateSet",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(DisgorgeServiceServer).CreateSet(ctx, req.(*SetRequest))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _DisgorgeService_DropSet_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(DropSetRequest)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(DisgorgeServiceServer).DropSet(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.DisgorgeService/DropSet",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(DisgorgeServiceServer).DropSet(ctx, req.(*DropSetRequest))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+var _DisgorgeService_serviceDesc = grpc.ServiceDesc{
+	ServiceName: "api.DisgorgeService",
+	HandlerType: (*DisgorgeServiceServer)(nil),
+	Methods: []grpc.MethodDesc{
+		{
+			MethodName: "Query",
+			Handler:    _DisgorgeService_Query_Handler,
+		},
+		{
+			MethodName: "MultiGet",
+			Handler:    _DisgorgeService_MultiGet_Handler,
+		},
+		{
+			MethodName: "CreateSet",
+			Handler:    _DisgorgeService_CreateSet_Handler,
+		},
+		{
+			MethodName: "DropSet",
+			Handler:    _DisgorgeService_DropSet_Handler,
+		},
+	},
+	Streams: []grpc.StreamDesc{
+		{
+			StreamName:    "QueryStream",
+			Handler:       _DisgorgeService_QueryStream_Handler,
+			ServerStreams: true,
+		},
+	},
+	Metadata: "api.proto",
+}
+
+func (m *Shard) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *Shard) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
+	var l int
+	_ = l
+	if len(m.Path) > 0 {
+		dAtA[i] = 0xa
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Path)))
+		i += copy(dAtA[i:], m.Path)
+	}
+	if len(m.Lastkey) > 0 {
+		dAtA[i] = 0x12
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Lastkey)))
+		i += copy(dAtA[i:], m.Lastkey)
+	}
+	if m.HasMore {
+		dAtA[i] = 0x18
+		i++
 		if m.HasMore {
 			dAtA[i] = 1
 		} else {
@@ -320,6 +778,16 @@ func (m *Shard) MarshalTo(dAtA []byte) (int, error) {
 		i++
 		i = encodeVarintApi(dAtA, i, uint64(m.Status))
 	}
+	if m.Cursor != 0 {
+		dAtA[i] = 0x28
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Cursor))
+	}
+	if m.Lastrange != 0 {
+		dAtA[i] = 0x30
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Lastrange))
+	}
 	return i, nil
 }
 
@@ -372,6 +840,72 @@ func (m *Request) MarshalTo(dAtA []byte) (int, error) {
 			i += n
 		}
 	}
+	if m.Profile != 0 {
+		dAtA[i] = 0x30
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Profile))
+	}
+	if m.LimitRows != 0 {
+		dAtA[i] = 0x38
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.LimitRows))
+	}
+	if m.LimitBytes != 0 {
+		dAtA[i] = 0x40
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.LimitBytes))
+	}
+	if m.TimeoutMs != 0 {
+		dAtA[i] = 0x48
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.TimeoutMs))
+	}
+	if m.MaxKeys != 0 {
+		dAtA[i] = 0x50
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.MaxKeys))
+	}
+	if m.Reverse {
+		dAtA[i] = 0x58
+		i++
+		if m.Reverse {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
+		}
+		i++
+	}
+	if len(m.UserIds) > 0 {
+		for _, s := range m.UserIds {
+			dAtA[i] = 0x62
+			i++
+			l = len(s)
+			for l >= 1<<7 {
+				dAtA[i] = uint8(uint64(l)&0x7f | 0x80)
+				l >>= 7
+				i++
+			}
+			dAtA[i] = uint8(l)
+			i++
+			i += copy(dAtA[i:], s)
+		}
+	}
+	if len(m.Token) > 0 {
+		dAtA[i] = 0x6a
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Token)))
+		i += copy(dAtA[i:], m.Token)
+	}
+	if m.Compact {
+		dAtA[i] = 0x70
+		i++
+		if m.Compact {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
+		}
+		i++
+	}
 	return i, nil
 }
 
@@ -452,100 +986,490 @@ func (m *Response) MarshalTo(dAtA []byte) (int, error) {
 			i += n
 		}
 	}
+	if len(m.Token) > 0 {
+		dAtA[i] = 0x22
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Token)))
+		i += copy(dAtA[i:], m.Token)
+	}
 	return i, nil
 }
 
-func encodeVarintApi(dAtA []byte, offset int, v uint64) int {
-	for v >= 1<<7 {
-		dAtA[offset] = uint8(v&0x7f | 0x80)
-		v >>= 7
-		offset++
-	}
-	dAtA[offset] = uint8(v)
-	return offset + 1
-}
-func (m *Shard) Size() (n int) {
-	var l int
-	_ = l
-	l = len(m.Path)
-	if l > 0 {
-		n += 1 + l + sovApi(uint64(l))
-	}
-	l = len(m.Lastkey)
-	if l > 0 {
-		n += 1 + l + sovApi(uint64(l))
-	}
-	if m.HasMore {
-		n += 2
-	}
-	if m.Status != 0 {
-		n += 1 + sovApi(uint64(m.Status))
+func (m *Chunk) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
 	}
-	return n
+	return dAtA[:n], nil
 }
 
-func (m *Request) Size() (n int) {
+func (m *Chunk) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
 	var l int
 	_ = l
-	l = len(m.UserId)
-	if l > 0 {
-		n += 1 + l + sovApi(uint64(l))
+	if m.Code != 0 {
+		dAtA[i] = 0x8
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Code))
 	}
-	l = len(m.Query)
-	if l > 0 {
-		n += 1 + l + sovApi(uint64(l))
+	if len(m.Path) > 0 {
+		dAtA[i] = 0x12
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Path)))
+		i += copy(dAtA[i:], m.Path)
 	}
-	if m.Start != 0 {
-		n += 1 + sovApi(uint64(m.Start))
+	if m.Data != nil {
+		dAtA[i] = 0x1a
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Data.Size()))
+		n1, err := m.Data.MarshalTo(dAtA[i:])
+		if err != nil {
+			return 0, err
+		}
+		i += n1
 	}
-	if m.End != 0 {
-		n += 1 + sovApi(uint64(m.End))
+	if len(m.Token) > 0 {
+		dAtA[i] = 0x22
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Token)))
+		i += copy(dAtA[i:], m.Token)
 	}
-	if len(m.Shards) > 0 {
-		for _, e := range m.Shards {
-			l = e.Size()
-			n += 1 + l + sovApi(uint64(l))
+	if m.Done {
+		dAtA[i] = 0x28
+		i++
+		if m.Done {
+			dAtA[i] = 1
+		} else {
+			dAtA[i] = 0
 		}
+		i++
 	}
-	return n
+	return i, nil
 }
 
-func (m *Data) Size() (n int) {
+func (m *MultiGetRequest) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *MultiGetRequest) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
 	var l int
 	_ = l
-	if len(m.Items) > 0 {
-		for _, s := range m.Items {
+	if len(m.Keys) > 0 {
+		for _, s := range m.Keys {
+			dAtA[i] = 0xa
+			i++
 			l = len(s)
-			n += 1 + l + sovApi(uint64(l))
+			for l >= 1<<7 {
+				dAtA[i] = uint8(uint64(l)&0x7f | 0x80)
+				l >>= 7
+				i++
+			}
+			dAtA[i] = uint8(l)
+			i++
+			i += copy(dAtA[i:], s)
 		}
 	}
-	return n
+	if m.Profile != 0 {
+		dAtA[i] = 0x10
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Profile))
+	}
+	return i, nil
 }
 
-func (m *Response) Size() (n int) {
+func (m *MultiGetResponse) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *MultiGetResponse) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
 	var l int
 	_ = l
 	if m.Code != 0 {
-		n += 1 + sovApi(uint64(m.Code))
+		dAtA[i] = 0x8
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Code))
 	}
-	if len(m.Shards) > 0 {
-		for _, e := range m.Shards {
-			l = e.Size()
-			n += 1 + l + sovApi(uint64(l))
+	if len(m.Values) > 0 {
+		for _, s := range m.Values {
+			dAtA[i] = 0x12
+			i++
+			l = len(s)
+			for l >= 1<<7 {
+				dAtA[i] = uint8(uint64(l)&0x7f | 0x80)
+				l >>= 7
+				i++
+			}
+			dAtA[i] = uint8(l)
+			i++
+			i += copy(dAtA[i:], s)
 		}
 	}
-	if len(m.Data) > 0 {
-		for _, e := range m.Data {
-			l = e.Size()
-			n += 1 + l + sovApi(uint64(l))
+	if len(m.Found) > 0 {
+		dAtA[i] = 0x1a
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(len(m.Found)))
+		for _, b := range m.Found {
+			if b {
+				dAtA[i] = 1
+			} else {
+				dAtA[i] = 0
+			}
+			i++
 		}
 	}
-	return n
+	return i, nil
 }
 
-func sovApi(x uint64) (n int) {
-	for {
-		n++
+func (m *SetRequest) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *SetRequest) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
+	var l int
+	_ = l
+	if len(m.Values) > 0 {
+		for _, s := range m.Values {
+			dAtA[i] = 0xa
+			i++
+			l = len(s)
+			for l >= 1<<7 {
+				dAtA[i] = uint8(uint64(l)&0x7f | 0x80)
+				l >>= 7
+				i++
+			}
+			dAtA[i] = uint8(l)
+			i++
+			i += copy(dAtA[i:], s)
+		}
+	}
+	if len(m.Ints) > 0 {
+		dAtA2 := make([]byte, len(m.Ints)*10)
+		var j2 int
+		for _, num2 := range m.Ints {
+			num := uint64(num2)
+			for num >= 1<<7 {
+				dAtA2[j2] = uint8(uint64(num)&0x7f | 0x80)
+				num >>= 7
+				j2++
+			}
+			dAtA2[j2] = uint8(num)
+			j2++
+		}
+		dAtA[i] = 0x12
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(j2))
+		i += copy(dAtA[i:], dAtA2[:j2])
+	}
+	return i, nil
+}
+
+func (m *SetResponse) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *SetResponse) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
+	var l int
+	_ = l
+	if m.Code != 0 {
+		dAtA[i] = 0x8
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Code))
+	}
+	if m.Set != 0 {
+		dAtA[i] = 0x10
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Set))
+	}
+	return i, nil
+}
+
+func (m *DropSetRequest) Marshal() (dAtA []byte, err error) {
+	size := m.Size()
+	dAtA = make([]byte, size)
+	n, err := m.MarshalTo(dAtA)
+	if err != nil {
+		return nil, err
+	}
+	return dAtA[:n], nil
+}
+
+func (m *DropSetRequest) MarshalTo(dAtA []byte) (int, error) {
+	var i int
+	_ = i
+	var l int
+	_ = l
+	if m.Set != 0 {
+		dAtA[i] = 0x8
+		i++
+		i = encodeVarintApi(dAtA, i, uint64(m.Set))
+	}
+	return i, nil
+}
+
+func encodeVarintApi(dAtA []byte, offset int, v uint64) int {
+	for v >= 1<<7 {
+		dAtA[offset] = uint8(v&0x7f | 0x80)
+		v >>= 7
+		offset++
+	}
+	dAtA[offset] = uint8(v)
+	return offset + 1
+}
+func (m *Shard) Size() (n int) {
+	var l int
+	_ = l
+	l = len(m.Path)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	l = len(m.Lastkey)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	if m.HasMore {
+		n += 2
+	}
+	if m.Status != 0 {
+		n += 1 + sovApi(uint64(m.Status))
+	}
+	if m.Cursor != 0 {
+		n += 1 + sovApi(uint64(m.Cursor))
+	}
+	if m.Lastrange != 0 {
+		n += 1 + sovApi(uint64(m.Lastrange))
+	}
+	return n
+}
+
+func (m *Request) Size() (n int) {
+	var l int
+	_ = l
+	l = len(m.UserId)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	l = len(m.Query)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	if m.Start != 0 {
+		n += 1 + sovApi(uint64(m.Start))
+	}
+	if m.End != 0 {
+		n += 1 + sovApi(uint64(m.End))
+	}
+	if len(m.Shards) > 0 {
+		for _, e := range m.Shards {
+			l = e.Size()
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	if m.Profile != 0 {
+		n += 1 + sovApi(uint64(m.Profile))
+	}
+	if m.LimitRows != 0 {
+		n += 1 + sovApi(uint64(m.LimitRows))
+	}
+	if m.LimitBytes != 0 {
+		n += 1 + sovApi(uint64(m.LimitBytes))
+	}
+	if m.TimeoutMs != 0 {
+		n += 1 + sovApi(uint64(m.TimeoutMs))
+	}
+	if m.MaxKeys != 0 {
+		n += 1 + sovApi(uint64(m.MaxKeys))
+	}
+	if m.Reverse {
+		n += 2
+	}
+	if len(m.UserIds) > 0 {
+		for _, s := range m.UserIds {
+			l = len(s)
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	l = len(m.Token)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	if m.Compact {
+		n += 2
+	}
+	return n
+}
+
+func (m *Data) Size() (n int) {
+	var l int
+	_ = l
+	if len(m.Items) > 0 {
+		for _, s := range m.Items {
+			l = len(s)
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	return n
+}
+
+func (m *Response) Size() (n int) {
+	var l int
+	_ = l
+	if m.Code != 0 {
+		n += 1 + sovApi(uint64(m.Code))
+	}
+	if len(m.Shards) > 0 {
+		for _, e := range m.Shards {
+			l = e.Size()
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	if len(m.Data) > 0 {
+		for _, e := range m.Data {
+			l = e.Size()
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	l = len(m.Token)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	return n
+}
+
+func (m *Chunk) Size() (n int) {
+	var l int
+	_ = l
+	if m.Code != 0 {
+		n += 1 + sovApi(uint64(m.Code))
+	}
+	l = len(m.Path)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	if m.Data != nil {
+		l = m.Data.Size()
+		n += 1 + l + sovApi(uint64(l))
+	}
+	l = len(m.Token)
+	if l > 0 {
+		n += 1 + l + sovApi(uint64(l))
+	}
+	if m.Done {
+		n += 2
+	}
+	return n
+}
+
+func (m *MultiGetRequest) Size() (n int) {
+	var l int
+	_ = l
+	if len(m.Keys) > 0 {
+		for _, s := range m.Keys {
+			l = len(s)
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	if m.Profile != 0 {
+		n += 1 + sovApi(uint64(m.Profile))
+	}
+	return n
+}
+
+func (m *MultiGetResponse) Size() (n int) {
+	var l int
+	_ = l
+	if m.Code != 0 {
+		n += 1 + sovApi(uint64(m.Code))
+	}
+	if len(m.Values) > 0 {
+		for _, s := range m.Values {
+			l = len(s)
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	if len(m.Found) > 0 {
+		n += 1 + sovApi(uint64(len(m.Found))) + len(m.Found)*1
+	}
+	return n
+}
+
+func (m *SetRequest) Size() (n int) {
+	var l int
+	_ = l
+	if len(m.Values) > 0 {
+		for _, s := range m.Values {
+			l = len(s)
+			n += 1 + l + sovApi(uint64(l))
+		}
+	}
+	if len(m.Ints) > 0 {
+		l = 0
+		for _, e := range m.Ints {
+			l += sovApi(uint64(e))
+		}
+		n += 1 + sovApi(uint64(l)) + l
+	}
+	return n
+}
+
+func (m *SetResponse) Size() (n int) {
+	var l int
+	_ = l
+	if m.Code != 0 {
+		n += 1 + sovApi(uint64(m.Code))
+	}
+	if m.Set != 0 {
+		n += 1 + sovApi(uint64(m.Set))
+	}
+	return n
+}
+
+func (m *DropSetRequest) Size() (n int) {
+	var l int
+	_ = l
+	if m.Set != 0 {
+		n += 1 + sovApi(uint64(m.Set))
+	}
+	return n
+}
+
+func sovApi(x uint64) (n int) {
+	for {
+		n++
 		x >>= 7
 		if x == 0 {
 			break
@@ -618,7 +1542,194 @@ func (m *Shard) Unmarshal(dAtA []byte) error {
 			if wireType != 2 {
 				return fmt.Errorf("proto: wrong wireType = %d for field Lastkey", wireType)
 			}
-			var stringLen uint64
+			var byteLen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				byteLen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if byteLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + byteLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Lastkey = append(m.Lastkey[:0], dAtA[iNdEx:postIndex]...)
+			if m.Lastkey == nil {
+				m.Lastkey = []byte{}
+			}
+			iNdEx = postIndex
+		case 3:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field HasMore", wireType)
+			}
+			var v int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				v |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			m.HasMore = bool(v != 0)
+		case 4:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Status", wireType)
+			}
+			m.Status = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Status |= (ShardStatus(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 5:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Cursor", wireType)
+			}
+			m.Cursor = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Cursor |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 6:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Lastrange", wireType)
+			}
+			m.Lastrange = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Lastrange |= (uint32(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		default:
+			iNdEx = preIndex
+			skippy, err := skipApi(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if skippy < 0 {
+				return ErrInvalidLengthApi
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *Request) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowApi
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= (uint64(b) & 0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: Request: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: Request: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field UserId", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.UserId = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Query", wireType)
+			}
+			var stringLen uint64
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -641,13 +1752,649 @@ func (m *Shard) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Lastkey = string(dAtA[iNdEx:postIndex])
+			m.Query = string(dAtA[iNdEx:postIndex])
 			iNdEx = postIndex
 		case 3:
 			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field HasMore", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Start", wireType)
+			}
+			m.Start = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Start |= (int64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 4:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field End", wireType)
+			}
+			m.End = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.End |= (int64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 5:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Shards", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + msglen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Shards = append(m.Shards, &Shard{})
+			if err := m.Shards[len(m.Shards)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 6:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Profile", wireType)
+			}
+			m.Profile = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Profile |= (ScanProfile(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 7:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field LimitRows", wireType)
+			}
+			m.LimitRows = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.LimitRows |= (uint32(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 8:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field LimitBytes", wireType)
+			}
+			m.LimitBytes = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.LimitBytes |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 9:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field TimeoutMs", wireType)
+			}
+			m.TimeoutMs = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.TimeoutMs |= (uint32(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 10:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field MaxKeys", wireType)
+			}
+			m.MaxKeys = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.MaxKeys |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 11:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Reverse", wireType)
+			}
+			var v int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				v |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			m.Reverse = bool(v != 0)
+		case 12:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field UserIds", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.UserIds = append(m.UserIds, string(dAtA[iNdEx:postIndex]))
+			iNdEx = postIndex
+		case 13:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Token", wireType)
+			}
+			var byteLen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				byteLen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if byteLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + byteLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Token = append(m.Token[:0], dAtA[iNdEx:postIndex]...)
+			if m.Token == nil {
+				m.Token = []byte{}
+			}
+			iNdEx = postIndex
+		case 14:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Compact", wireType)
+			}
+			var v int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				v |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			m.Compact = bool(v != 0)
+		default:
+			iNdEx = preIndex
+			skippy, err := skipApi(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if skippy < 0 {
+				return ErrInvalidLengthApi
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *Data) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowApi
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= (uint64(b) & 0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: Data: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: Data: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Items", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Items = append(m.Items, string(dAtA[iNdEx:postIndex]))
+			iNdEx = postIndex
+		default:
+			iNdEx = preIndex
+			skippy, err := skipApi(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if skippy < 0 {
+				return ErrInvalidLengthApi
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *Response) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowApi
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= (uint64(b) & 0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: Response: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: Response: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Code", wireType)
+			}
+			m.Code = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Code |= (int32(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Shards", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + msglen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Shards = append(m.Shards, &Shard{})
+			if err := m.Shards[len(m.Shards)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 3:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Data", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + msglen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Data = append(m.Data, &Data{})
+			if err := m.Data[len(m.Data)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 4:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Token", wireType)
+			}
+			var byteLen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				byteLen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if byteLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + byteLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Token = append(m.Token[:0], dAtA[iNdEx:postIndex]...)
+			if m.Token == nil {
+				m.Token = []byte{}
+			}
+			iNdEx = postIndex
+		default:
+			iNdEx = preIndex
+			skippy, err := skipApi(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if skippy < 0 {
+				return ErrInvalidLengthApi
+			}
+			if (iNdEx + skippy) > l {
+				return io.ErrUnexpectedEOF
+			}
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *Chunk) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowApi
+			}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
+			}
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= (uint64(b) & 0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: Chunk: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: Chunk: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Code", wireType)
+			}
+			m.Code = 0
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				m.Code |= (int32(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+		case 2:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Path", wireType)
+			}
+			var stringLen uint64
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				stringLen |= (uint64(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + intStringLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Path = string(dAtA[iNdEx:postIndex])
+			iNdEx = postIndex
+		case 3:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Data", wireType)
+			}
+			var msglen int
+			for shift := uint(0); ; shift += 7 {
+				if shift >= 64 {
+					return ErrIntOverflowApi
+				}
+				if iNdEx >= l {
+					return io.ErrUnexpectedEOF
+				}
+				b := dAtA[iNdEx]
+				iNdEx++
+				msglen |= (int(b) & 0x7F) << shift
+				if b < 0x80 {
+					break
+				}
+			}
+			if msglen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + msglen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			if m.Data == nil {
+				m.Data = &Data{}
+			}
+			if err := m.Data.Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
+				return err
+			}
+			iNdEx = postIndex
+		case 4:
+			if wireType != 2 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Token", wireType)
 			}
-			var v int
+			var byteLen int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -657,17 +2404,28 @@ func (m *Shard) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				v |= (int(b) & 0x7F) << shift
+				byteLen |= (int(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			m.HasMore = bool(v != 0)
-		case 4:
+			if byteLen < 0 {
+				return ErrInvalidLengthApi
+			}
+			postIndex := iNdEx + byteLen
+			if postIndex > l {
+				return io.ErrUnexpectedEOF
+			}
+			m.Token = append(m.Token[:0], dAtA[iNdEx:postIndex]...)
+			if m.Token == nil {
+				m.Token = []byte{}
+			}
+			iNdEx = postIndex
+		case 5:
 			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Status", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Done", wireType)
 			}
-			m.Status = 0
+			var v int
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -677,11 +2435,12 @@ func (m *Shard) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				m.Status |= (ShardStatus(b) & 0x7F) << shift
+				v |= (int(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
+			m.Done = bool(v != 0)
 		default:
 			iNdEx = preIndex
 			skippy, err := skipApi(dAtA[iNdEx:])
@@ -703,7 +2462,7 @@ func (m *Shard) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *Request) Unmarshal(dAtA []byte) error {
+func (m *MultiGetRequest) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -726,15 +2485,15 @@ func (m *Request) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: Request: wiretype end group for non-group")
+			return fmt.Errorf("proto: MultiGetRequest: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: Request: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: MultiGetRequest: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field UserId", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Keys", wireType)
 			}
 			var stringLen uint64
 			for shift := uint(0); ; shift += 7 {
@@ -759,13 +2518,13 @@ func (m *Request) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.UserId = string(dAtA[iNdEx:postIndex])
+			m.Keys = append(m.Keys, string(dAtA[iNdEx:postIndex]))
 			iNdEx = postIndex
 		case 2:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Query", wireType)
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Profile", wireType)
 			}
-			var stringLen uint64
+			m.Profile = 0
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -775,45 +2534,66 @@ func (m *Request) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				stringLen |= (uint64(b) & 0x7F) << shift
+				m.Profile |= (ScanProfile(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			intStringLen := int(stringLen)
-			if intStringLen < 0 {
+		default:
+			iNdEx = preIndex
+			skippy, err := skipApi(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if skippy < 0 {
 				return ErrInvalidLengthApi
 			}
-			postIndex := iNdEx + intStringLen
-			if postIndex > l {
+			if (iNdEx + skippy) > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Query = string(dAtA[iNdEx:postIndex])
-			iNdEx = postIndex
-		case 3:
-			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Start", wireType)
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *MultiGetResponse) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowApi
 			}
-			m.Start = 0
-			for shift := uint(0); ; shift += 7 {
-				if shift >= 64 {
-					return ErrIntOverflowApi
-				}
-				if iNdEx >= l {
-					return io.ErrUnexpectedEOF
-				}
-				b := dAtA[iNdEx]
-				iNdEx++
-				m.Start |= (int64(b) & 0x7F) << shift
-				if b < 0x80 {
-					break
-				}
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
 			}
-		case 4:
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= (uint64(b) & 0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: MultiGetResponse: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: MultiGetResponse: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
 			if wireType != 0 {
-				return fmt.Errorf("proto: wrong wireType = %d for field End", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Code", wireType)
 			}
-			m.End = 0
+			m.Code = 0
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -823,16 +2603,16 @@ func (m *Request) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				m.End |= (int64(b) & 0x7F) << shift
+				m.Code |= (int32(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-		case 5:
+		case 2:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Shards", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Values", wireType)
 			}
-			var msglen int
+			var stringLen uint64
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -842,23 +2622,83 @@ func (m *Request) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				msglen |= (int(b) & 0x7F) << shift
+				stringLen |= (uint64(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			if msglen < 0 {
+			intStringLen := int(stringLen)
+			if intStringLen < 0 {
 				return ErrInvalidLengthApi
 			}
-			postIndex := iNdEx + msglen
+			postIndex := iNdEx + intStringLen
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Shards = append(m.Shards, &Shard{})
-			if err := m.Shards[len(m.Shards)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
-			}
+			m.Values = append(m.Values, string(dAtA[iNdEx:postIndex]))
 			iNdEx = postIndex
+		case 3:
+			if wireType == 0 {
+				var v int
+				for shift := uint(0); ; shift += 7 {
+					if shift >= 64 {
+						return ErrIntOverflowApi
+					}
+					if iNdEx >= l {
+						return io.ErrUnexpectedEOF
+					}
+					b := dAtA[iNdEx]
+					iNdEx++
+					v |= (int(b) & 0x7F) << shift
+					if b < 0x80 {
+						break
+					}
+				}
+				m.Found = append(m.Found, bool(v != 0))
+			} else if wireType == 2 {
+				var packedLen int
+				for shift := uint(0); ; shift += 7 {
+					if shift >= 64 {
+						return ErrIntOverflowApi
+					}
+					if iNdEx >= l {
+						return io.ErrUnexpectedEOF
+					}
+					b := dAtA[iNdEx]
+					iNdEx++
+					packedLen |= (int(b) & 0x7F) << shift
+					if b < 0x80 {
+						break
+					}
+				}
+				if packedLen < 0 {
+					return ErrInvalidLengthApi
+				}
+				postIndex := iNdEx + packedLen
+				if postIndex > l {
+					return io.ErrUnexpectedEOF
+				}
+				for iNdEx < postIndex {
+					var v int
+					for shift := uint(0); ; shift += 7 {
+						if shift >= 64 {
+							return ErrIntOverflowApi
+						}
+						if iNdEx >= l {
+							return io.ErrUnexpectedEOF
+						}
+						b := dAtA[iNdEx]
+						iNdEx++
+						v |= (int(b) & 0x7F) << shift
+						if b < 0x80 {
+							break
+						}
+					}
+					m.Found = append(m.Found, bool(v != 0))
+				}
+			} else {
+				return fmt.Errorf("proto: wrong wireType = %d for field Found", wireType)
+			}
 		default:
 			iNdEx = preIndex
 			skippy, err := skipApi(dAtA[iNdEx:])
@@ -880,7 +2720,7 @@ func (m *Request) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *Data) Unmarshal(dAtA []byte) error {
+func (m *SetRequest) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -903,15 +2743,15 @@ func (m *Data) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: Data: wiretype end group for non-group")
+			return fmt.Errorf("proto: SetRequest: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: Data: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: SetRequest: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
 			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Items", wireType)
+				return fmt.Errorf("proto: wrong wireType = %d for field Values", wireType)
 			}
 			var stringLen uint64
 			for shift := uint(0); ; shift += 7 {
@@ -936,8 +2776,70 @@ func (m *Data) Unmarshal(dAtA []byte) error {
 			if postIndex > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Items = append(m.Items, string(dAtA[iNdEx:postIndex]))
+			m.Values = append(m.Values, string(dAtA[iNdEx:postIndex]))
 			iNdEx = postIndex
+		case 2:
+			if wireType == 0 {
+				var v int64
+				for shift := uint(0); ; shift += 7 {
+					if shift >= 64 {
+						return ErrIntOverflowApi
+					}
+					if iNdEx >= l {
+						return io.ErrUnexpectedEOF
+					}
+					b := dAtA[iNdEx]
+					iNdEx++
+					v |= (int64(b) & 0x7F) << shift
+					if b < 0x80 {
+						break
+					}
+				}
+				m.Ints = append(m.Ints, v)
+			} else if wireType == 2 {
+				var packedLen int
+				for shift := uint(0); ; shift += 7 {
+					if shift >= 64 {
+						return ErrIntOverflowApi
+					}
+					if iNdEx >= l {
+						return io.ErrUnexpectedEOF
+					}
+					b := dAtA[iNdEx]
+					iNdEx++
+					packedLen |= (int(b) & 0x7F) << shift
+					if b < 0x80 {
+						break
+					}
+				}
+				if packedLen < 0 {
+					return ErrInvalidLengthApi
+				}
+				postIndex := iNdEx + packedLen
+				if postIndex > l {
+					return io.ErrUnexpectedEOF
+				}
+				for iNdEx < postIndex {
+					var v int64
+					for shift := uint(0); ; shift += 7 {
+						if shift >= 64 {
+							return ErrIntOverflowApi
+						}
+						if iNdEx >= l {
+							return io.ErrUnexpectedEOF
+						}
+						b := dAtA[iNdEx]
+						iNdEx++
+						v |= (int64(b) & 0x7F) << shift
+						if b < 0x80 {
+							break
+						}
+					}
+					m.Ints = append(m.Ints, v)
+				}
+			} else {
+				return fmt.Errorf("proto: wrong wireType = %d for field Ints", wireType)
+			}
 		default:
 			iNdEx = preIndex
 			skippy, err := skipApi(dAtA[iNdEx:])
@@ -959,7 +2861,7 @@ func (m *Data) Unmarshal(dAtA []byte) error {
 	}
 	return nil
 }
-func (m *Response) Unmarshal(dAtA []byte) error {
+func (m *SetResponse) Unmarshal(dAtA []byte) error {
 	l := len(dAtA)
 	iNdEx := 0
 	for iNdEx < l {
@@ -982,10 +2884,10 @@ func (m *Response) Unmarshal(dAtA []byte) error {
 		fieldNum := int32(wire >> 3)
 		wireType := int(wire & 0x7)
 		if wireType == 4 {
-			return fmt.Errorf("proto: Response: wiretype end group for non-group")
+			return fmt.Errorf("proto: SetResponse: wiretype end group for non-group")
 		}
 		if fieldNum <= 0 {
-			return fmt.Errorf("proto: Response: illegal tag %d (wire type %d)", fieldNum, wire)
+			return fmt.Errorf("proto: SetResponse: illegal tag %d (wire type %d)", fieldNum, wire)
 		}
 		switch fieldNum {
 		case 1:
@@ -1008,10 +2910,10 @@ func (m *Response) Unmarshal(dAtA []byte) error {
 				}
 			}
 		case 2:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Shards", wireType)
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Set", wireType)
 			}
-			var msglen int
+			m.Set = 0
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -1021,28 +2923,66 @@ func (m *Response) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				msglen |= (int(b) & 0x7F) << shift
+				m.Set |= (uint64(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			if msglen < 0 {
+		default:
+			iNdEx = preIndex
+			skippy, err := skipApi(dAtA[iNdEx:])
+			if err != nil {
+				return err
+			}
+			if skippy < 0 {
 				return ErrInvalidLengthApi
 			}
-			postIndex := iNdEx + msglen
-			if postIndex > l {
+			if (iNdEx + skippy) > l {
 				return io.ErrUnexpectedEOF
 			}
-			m.Shards = append(m.Shards, &Shard{})
-			if err := m.Shards[len(m.Shards)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
+			iNdEx += skippy
+		}
+	}
+
+	if iNdEx > l {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
+func (m *DropSetRequest) Unmarshal(dAtA []byte) error {
+	l := len(dAtA)
+	iNdEx := 0
+	for iNdEx < l {
+		preIndex := iNdEx
+		var wire uint64
+		for shift := uint(0); ; shift += 7 {
+			if shift >= 64 {
+				return ErrIntOverflowApi
 			}
-			iNdEx = postIndex
-		case 3:
-			if wireType != 2 {
-				return fmt.Errorf("proto: wrong wireType = %d for field Data", wireType)
+			if iNdEx >= l {
+				return io.ErrUnexpectedEOF
 			}
-			var msglen int
+			b := dAtA[iNdEx]
+			iNdEx++
+			wire |= (uint64(b) & 0x7F) << shift
+			if b < 0x80 {
+				break
+			}
+		}
+		fieldNum := int32(wire >> 3)
+		wireType := int(wire & 0x7)
+		if wireType == 4 {
+			return fmt.Errorf("proto: DropSetRequest: wiretype end group for non-group")
+		}
+		if fieldNum <= 0 {
+			return fmt.Errorf("proto: DropSetRequest: illegal tag %d (wire type %d)", fieldNum, wire)
+		}
+		switch fieldNum {
+		case 1:
+			if wireType != 0 {
+				return fmt.Errorf("proto: wrong wireType = %d for field Set", wireType)
+			}
+			m.Set = 0
 			for shift := uint(0); ; shift += 7 {
 				if shift >= 64 {
 					return ErrIntOverflowApi
@@ -1052,23 +2992,11 @@ func (m *Response) Unmarshal(dAtA []byte) error {
 				}
 				b := dAtA[iNdEx]
 				iNdEx++
-				msglen |= (int(b) & 0x7F) << shift
+				m.Set |= (uint64(b) & 0x7F) << shift
 				if b < 0x80 {
 					break
 				}
 			}
-			if msglen < 0 {
-				return ErrInvalidLengthApi
-			}
-			postIndex := iNdEx + msglen
-			if postIndex > l {
-				return io.ErrUnexpectedEOF
-			}
-			m.Data = append(m.Data, &Data{})
-			if err := m.Data[len(m.Data)-1].Unmarshal(dAtA[iNdEx:postIndex]); err != nil {
-				return err
-			}
-			iNdEx = postIndex
 		default:
 			iNdEx = preIndex
 			skippy, err := skipApi(dAtA[iNdEx:])
@@ -1198,29 +3126,53 @@ var (
 func init() { proto.RegisterFile("api.proto", fileDescriptorApi) }
 
 var fileDescriptorApi = []byte{
-	// 384 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x74, 0x92, 0x41, 0x8b, 0xd4, 0x30,
-	0x14, 0xc7, 0x27, 0x93, 0xb6, 0x3b, 0x7d, 0xbb, 0xae, 0x25, 0x88, 0x04, 0xd1, 0x52, 0x7a, 0x90,
-	0xe2, 0x61, 0x84, 0xf1, 0x24, 0xde, 0x64, 0x5d, 0xd8, 0x83, 0xa2, 0xe9, 0xcd, 0x5b, 0xdc, 0x3e,
-	0xa6, 0x41, 0x6d, 0xba, 0x79, 0xa9, 0x30, 0x67, 0xbf, 0x84, 0x1f, 0xc9, 0xa3, 0x1f, 0x41, 0xc6,
-	0x2f, 0x22, 0xc9, 0x74, 0x70, 0x2e, 0xde, 0xde, 0xef, 0xff, 0x42, 0x7f, 0xc9, 0x9f, 0x42, 0xae,
-	0x47, 0xb3, 0x1e, 0x9d, 0xf5, 0x56, 0x70, 0x3d, 0x9a, 0x7a, 0x07, 0x69, 0xdb, 0x6b, 0xd7, 0x09,
-	0x01, 0xc9, 0xa8, 0x7d, 0x2f, 0x59, 0xc5, 0x9a, 0x5c, 0xc5, 0x59, 0x48, 0x38, 0xfb, 0xa2, 0xc9,
-	0x7f, 0xc6, 0x9d, 0x5c, 0xc6, 0xf8, 0x88, 0x61, 0xd3, 0x6b, 0x7a, 0x6b, 0x1d, 0x4a, 0x5e, 0xb1,
-	0x66, 0xa5, 0x8e, 0x28, 0x1a, 0xc8, 0xc8, 0x6b, 0x3f, 0x91, 0x4c, 0x2a, 0xd6, 0x5c, 0x6e, 0x8a,
-	0x75, 0x30, 0x46, 0x47, 0x1b, 0x73, 0x35, 0xef, 0xeb, 0xef, 0x0c, 0xce, 0x14, 0xde, 0x4d, 0x48,
-	0x5e, 0x3c, 0x84, 0x6c, 0x22, 0x74, 0x37, 0xdd, 0xec, 0x9f, 0x49, 0x3c, 0x80, 0xf4, 0x6e, 0x42,
-	0x77, 0xf4, 0x1f, 0x20, 0xa4, 0xe4, 0xb5, 0xf3, 0xd1, 0xcd, 0xd5, 0x01, 0x44, 0x01, 0x1c, 0x87,
-	0x2e, 0x6a, 0xb9, 0x0a, 0xa3, 0xa8, 0x21, 0xa3, 0x20, 0x26, 0x99, 0x56, 0xbc, 0x39, 0xdf, 0xc0,
-	0xbf, 0xbb, 0xa8, 0x79, 0x53, 0x3f, 0x86, 0xe4, 0x4a, 0x7b, 0x1d, 0xbe, 0x69, 0x3c, 0x7e, 0x25,
-	0xc9, 0x2a, 0x1e, 0x4c, 0x11, 0x6a, 0x0d, 0x2b, 0x85, 0x34, 0xda, 0x81, 0x30, 0x34, 0x74, 0x6b,
-	0x3b, 0x8c, 0x37, 0x4c, 0x55, 0x9c, 0x4f, 0x0c, 0xcb, 0xff, 0x19, 0xc4, 0x13, 0x48, 0x3a, 0xed,
-	0xb5, 0xe4, 0xf1, 0x44, 0x1e, 0x4f, 0x04, 0xa5, 0x8a, 0xf1, 0xb3, 0x6b, 0x38, 0x3f, 0x69, 0x47,
-	0xe4, 0x90, 0xbe, 0x71, 0xce, 0xba, 0x62, 0x21, 0x2e, 0x01, 0xde, 0x59, 0xdf, 0x86, 0xc7, 0x61,
-	0x57, 0xb0, 0xc0, 0x37, 0xc3, 0x7b, 0x67, 0xb7, 0x0e, 0x89, 0x8a, 0xa5, 0xb8, 0x80, 0xd5, 0xb5,
-	0x19, 0x0c, 0xf5, 0xd8, 0x15, 0x7c, 0xf3, 0x12, 0xee, 0x5f, 0x19, 0xda, 0x5a, 0xb7, 0xc5, 0x16,
-	0xdd, 0x37, 0x73, 0x8b, 0xe2, 0x29, 0xa4, 0x1f, 0x62, 0x61, 0x17, 0x51, 0x3a, 0x97, 0xfd, 0xe8,
-	0xde, 0x4c, 0x87, 0x77, 0xd5, 0x8b, 0xd7, 0xf2, 0xe7, 0xbe, 0x64, 0xbf, 0xf6, 0x25, 0xfb, 0xbd,
-	0x2f, 0xd9, 0x8f, 0x3f, 0xe5, 0xe2, 0x63, 0xb6, 0x7e, 0xfe, 0x4a, 0x8f, 0xe6, 0x53, 0x16, 0x7f,
-	0x95, 0x17, 0x7f, 0x03, 0x00, 0x00, 0xff, 0xff, 0x69, 0xd3, 0xd4, 0xaf, 0x37, 0x02, 0x00, 0x00,
+	// 755 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x8d, 0x55, 0x4d, 0x6e, 0xd3, 0x40,
+	0x14, 0x8e, 0x63, 0xe7, 0xc7, 0x2f, 0x69, 0x62, 0x0d, 0x05, 0x8d, 0xaa, 0x52, 0x21, 0x2f, 0x50,
+	0xd4, 0x4a, 0xa5, 0x4a, 0x37, 0x20, 0x24, 0x16, 0x6d, 0x29, 0xaa, 0x50, 0x11, 0x9d, 0xec, 0xd8,
+	0x99, 0x64, 0x48, 0xac, 0x24, 0x76, 0x98, 0x19, 0xa7, 0xed, 0x09, 0x10, 0x37, 0xe0, 0x16, 0x5c,
+	0x83, 0x25, 0x47, 0x40, 0x70, 0x11, 0xde, 0xcc, 0xd8, 0x71, 0xa8, 0x0a, 0x65, 0x11, 0xe9, 0x7d,
+	0xef, 0xef, 0x7b, 0x7f, 0xe3, 0x80, 0x1f, 0x2d, 0xe2, 0xfd, 0x85, 0x48, 0x55, 0x4a, 0x5c, 0x14,
+	0xc3, 0xaf, 0x0e, 0xd4, 0x06, 0x93, 0x48, 0x8c, 0x08, 0x01, 0x6f, 0x11, 0xa9, 0x09, 0x75, 0x1e,
+	0x39, 0x3d, 0x9f, 0x19, 0x99, 0x50, 0x68, 0xcc, 0x22, 0xa9, 0xa6, 0xfc, 0x9a, 0x56, 0x51, 0xdd,
+	0x66, 0x05, 0xd4, 0x96, 0x49, 0x24, 0xcf, 0x53, 0xc1, 0xa9, 0x8b, 0x96, 0x26, 0x2b, 0x20, 0xe9,
+	0x41, 0x5d, 0xaa, 0x48, 0x65, 0x92, 0x7a, 0x68, 0xe8, 0xf4, 0x83, 0x7d, 0x4d, 0x69, 0x38, 0x06,
+	0x46, 0xcf, 0x72, 0x3b, 0x79, 0x00, 0xf5, 0x61, 0x26, 0x64, 0x2a, 0x68, 0x0d, 0x3d, 0x3d, 0x96,
+	0x23, 0xb2, 0x0d, 0xbe, 0xa6, 0x11, 0x51, 0x32, 0xe6, 0xb4, 0x8e, 0xa6, 0x0d, 0x56, 0x2a, 0xc2,
+	0xcf, 0x2e, 0x34, 0x18, 0xff, 0x98, 0x71, 0xa9, 0x74, 0x86, 0x4c, 0x72, 0x71, 0x36, 0xca, 0xab,
+	0xce, 0x11, 0xd9, 0x84, 0x1a, 0x3a, 0x08, 0x5b, 0xb5, 0xcf, 0x2c, 0xd0, 0x5a, 0x64, 0x16, 0xca,
+	0x54, 0xec, 0x32, 0x0b, 0x48, 0x00, 0x2e, 0x4f, 0x46, 0xa6, 0x58, 0x97, 0x69, 0x91, 0x84, 0xd8,
+	0x81, 0x2e, 0x57, 0x62, 0x5d, 0x6e, 0xaf, 0xd5, 0x87, 0xb2, 0x03, 0x96, 0x5b, 0xc8, 0x2e, 0x34,
+	0x70, 0x8a, 0x1f, 0xe2, 0x99, 0xad, 0x70, 0xd5, 0xe6, 0x30, 0x4a, 0xde, 0x5a, 0x3d, 0x2b, 0x1c,
+	0x4c, 0x3f, 0xf1, 0x3c, 0x56, 0x2c, 0xbd, 0x94, 0xb4, 0x91, 0xf7, 0x53, 0x28, 0xc8, 0x0e, 0x80,
+	0x01, 0x47, 0xd7, 0x8a, 0x4b, 0xda, 0x34, 0x93, 0x58, 0xd3, 0xe8, 0x68, 0x15, 0xcf, 0x79, 0x9a,
+	0xa9, 0x73, 0x49, 0x7d, 0x1b, 0xbd, 0x52, 0xe8, 0x3d, 0xcc, 0xa3, 0xab, 0xd7, 0xfc, 0x5a, 0x52,
+	0x30, 0xa1, 0x05, 0xd4, 0x16, 0xc1, 0x97, 0x5c, 0x48, 0x4e, 0x5b, 0x76, 0x43, 0x39, 0xd4, 0x16,
+	0x3b, 0x27, 0x49, 0xdb, 0xd8, 0xa0, 0xcf, 0x0a, 0xa8, 0x27, 0xa4, 0xd2, 0x29, 0x4f, 0xe8, 0x86,
+	0xd9, 0xb6, 0x05, 0xda, 0x7f, 0x98, 0xce, 0x17, 0xd1, 0x50, 0xd1, 0x8e, 0xcd, 0x94, 0xc3, 0x70,
+	0x1b, 0xbc, 0x93, 0x48, 0x45, 0x3a, 0x2e, 0x56, 0x7c, 0x2e, 0x71, 0x0d, 0x3a, 0x9f, 0x05, 0xe1,
+	0x25, 0x34, 0x19, 0x97, 0x8b, 0x34, 0x41, 0x4e, 0xbc, 0xae, 0x61, 0x3a, 0xe2, 0x66, 0x4f, 0x35,
+	0x66, 0xe4, 0xb5, 0x39, 0x57, 0xff, 0x3a, 0xe7, 0x87, 0xe0, 0x8d, 0x90, 0x01, 0x57, 0xa6, 0x3d,
+	0x7c, 0xe3, 0xa1, 0x29, 0x99, 0x51, 0x97, 0x05, 0x7b, 0x6b, 0x05, 0x87, 0x57, 0x50, 0x3b, 0x9e,
+	0x64, 0xc9, 0xf4, 0x56, 0xd6, 0xe2, 0xce, 0xab, 0x6b, 0x77, 0x5e, 0xb2, 0x38, 0xff, 0xcd, 0xa2,
+	0x13, 0x8d, 0xd2, 0x84, 0x9b, 0xe3, 0x6d, 0x32, 0x23, 0x87, 0x17, 0xd0, 0x3d, 0xcf, 0x66, 0x2a,
+	0x7e, 0xc5, 0x55, 0x71, 0xa3, 0xe8, 0x36, 0xd5, 0xeb, 0xb1, 0xa3, 0x31, 0xf2, 0xfa, 0xf5, 0x54,
+	0xef, 0xb8, 0x9e, 0xf0, 0x05, 0x04, 0x65, 0xca, 0x7f, 0x4c, 0x13, 0xdf, 0xc2, 0x32, 0x9a, 0x21,
+	0xa5, 0x99, 0x26, 0xbe, 0x05, 0x8b, 0xc2, 0xa7, 0x00, 0x83, 0xb2, 0x9a, 0xd2, 0xcb, 0x59, 0xf7,
+	0xd2, 0x19, 0xe3, 0x44, 0xd9, 0x58, 0x97, 0x19, 0x39, 0x3c, 0x84, 0xd6, 0xe0, 0x0e, 0x52, 0x7c,
+	0x3c, 0x92, 0x2b, 0xd3, 0x84, 0xc7, 0xb4, 0x18, 0x86, 0xd0, 0x39, 0x11, 0xe9, 0x62, 0x8d, 0x32,
+	0xf7, 0x71, 0x56, 0x3e, 0xbb, 0xa7, 0x98, 0xb8, 0xfc, 0x1e, 0x10, 0x1f, 0x6a, 0x2f, 0x85, 0x48,
+	0x45, 0x50, 0x21, 0x1d, 0x80, 0x37, 0xa9, 0x1a, 0xe8, 0x87, 0xc9, 0x47, 0x81, 0xa3, 0xf1, 0x99,
+	0x1e, 0xc9, 0x58, 0x70, 0x29, 0x83, 0x2a, 0x69, 0x43, 0xf3, 0x34, 0x4e, 0x62, 0x39, 0x41, 0xab,
+	0xbb, 0xdb, 0xc3, 0x3c, 0xe5, 0xc8, 0x48, 0x17, 0x5a, 0x67, 0x89, 0xe2, 0x02, 0x2f, 0x33, 0x5e,
+	0x72, 0xcc, 0xd6, 0x04, 0xef, 0x28, 0x9b, 0x4d, 0x03, 0xa7, 0xff, 0xa9, 0x0a, 0xdd, 0x93, 0x58,
+	0x8e, 0x53, 0x31, 0xe6, 0x03, 0x2e, 0x96, 0xf1, 0x90, 0x93, 0xc7, 0x50, 0xbb, 0x30, 0xdf, 0x85,
+	0xb6, 0x19, 0x7e, 0x5e, 0xee, 0xd6, 0x46, 0x8e, 0x6c, 0xd7, 0x61, 0x85, 0xec, 0x41, 0xcb, 0xf8,
+	0x0d, 0x94, 0xe0, 0xd1, 0xfc, 0x86, 0xb7, 0xbd, 0x59, 0x73, 0x6d, 0x61, 0xe5, 0xc0, 0x21, 0xcf,
+	0xa0, 0x59, 0x6c, 0x8b, 0x6c, 0x1a, 0xdb, 0x8d, 0x7b, 0xd8, 0xba, 0x7f, 0x43, 0xbb, 0xe2, 0x39,
+	0x00, 0xff, 0x18, 0x19, 0x14, 0x16, 0xa8, 0x48, 0xd7, 0x1e, 0x44, 0x19, 0x16, 0x94, 0x8a, 0x55,
+	0x44, 0x1f, 0x1a, 0xf9, 0xac, 0xc9, 0x3d, 0x7b, 0xb3, 0x7f, 0x4c, 0xfe, 0xb6, 0x98, 0x23, 0xfa,
+	0xed, 0xe7, 0x8e, 0xf3, 0x1d, 0x7f, 0x3f, 0xf0, 0xf7, 0xe5, 0xd7, 0x4e, 0xe5, 0x5d, 0x7d, 0xff,
+	0xc9, 0x73, 0xf4, 0x7b, 0x5f, 0x37, 0x7f, 0x0b, 0x87, 0xbf, 0x01, 0xa1, 0xbd, 0xa3, 0xb4, 0x23,
+	0x06, 0x00, 0x00,
 }
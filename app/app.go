@@ -4,7 +4,10 @@ import (
 	"context"
 	"disgorge/api"
 	"disgorge/warehouse"
+	"encoding/base64"
+	"encoding/json"
 	"net/http"
+	"strconv"
 
 	"github.com/gin-gonic/gin"
 	"github.com/uopensail/ulib/prome"
@@ -28,17 +31,91 @@ func (app *App) GRPCAPIRegister(s *grpc.Server) {
 
 func (app *App) RegisterGinRouter(ginEngine *gin.Engine) {
 	ginEngine.POST("/query", app.QueryHandler)
+	ginEngine.POST("/query/stream", app.QueryStreamHandler)
+	ginEngine.POST("/multiget", app.MultiGetHandler)
+	ginEngine.POST("/set", app.CreateSetHandler)
+	ginEngine.POST("/set/drop", app.DropSetHandler)
 	ginEngine.GET("/", app.PingHandler)
 	ginEngine.GET("/version", app.VersionHandler)
 }
 
 func (app *App) Query(ctx context.Context, in *api.Request) (*api.Response, error) {
+	response, pages, err := app.query(ctx, in, warehouse.FormatData)
+	if err != nil || response == nil || pages == nil {
+		return response, err
+	}
+	// the pages are sent as they are, see encodePages; a server without it
+	// gets them decoded
+	if p, ok := ctx.Value(pagesKey{}).(*[][]byte); ok {
+		*p = pages
+		return response, nil
+	}
+	response.Data = make([]*api.Data, len(pages))
+	for i := 0; i < len(pages); i++ {
+		response.Data[i] = &api.Data{}
+		if err := response.Data[i].Unmarshal(pages[i]); err != nil {
+			return nil, err
+		}
+	}
+	return response, nil
+}
+
+func (app *App) query(ctx context.Context, in *api.Request, format warehouse.Format) (*api.Response, [][]byte, error) {
 	stat := prome.NewStat("App.Query")
 	defer stat.End()
-	response := warehouse.Query(in)
-	return response, nil
+	response, pages := warehouse.Query(ctx, in, format)
+	// the scans stopped early, what they found is incomplete
+	if err := ctx.Err(); err != nil {
+		stat.MarkErr()
+		return nil, nil, err
+	}
+	return response, pages, nil
 }
 
+// QueryStream sends the pages of the shards as they are read, see
+// warehouse.QueryStream
+func (app *App) QueryStream(in *api.Request, stream api.DisgorgeService_QueryStreamServer) error {
+	stat := prome.NewStat("App.QueryStream")
+	defer stat.End()
+	err := warehouse.QueryStream(stream.Context(), in, warehouse.FormatData, func(chunk *warehouse.Chunk) error {
+		return stream.SendMsg(encodeChunk(chunk))
+	})
+	if err != nil {
+		stat.MarkErr()
+	}
+	return err
+}
+
+// encodeChunk has the page of chunk sent as its data, without decoding it.
+// The chunks without rows, the last one and a rejected token, have no data.
+func encodeChunk(chunk *warehouse.Chunk) *encoded {
+	e := &encoded{
+		msg: &api.Chunk{
+			Code:  chunk.Code,
+			Path:  chunk.Path,
+			Token: chunk.Token,
+			Done:  chunk.Done,
+		},
+	}
+	if len(chunk.Body) > 0 {
+		e.pages = [][]byte{chunk.Body}
+	}
+	return e
+}
+
+// jsonResponse is api.Response with the items of each shard as the json
+// array libdisgorge encoded
+type jsonResponse struct {
+	*api.Response
+	Data []*jsonData `json:"data,omitempty"`
+}
+
+type jsonData struct {
+	Items json.RawMessage `json:"items,omitempty"`
+}
+
+// QueryHandler answers with the items as strings, or as the json documents
+// they are with ?raw=true
 func (app *App) QueryHandler(gCtx *gin.Context) {
 	stat := prome.NewStat("App.QueryEchoHandler")
 	defer stat.End()
@@ -47,11 +124,136 @@ func (app *App) QueryHandler(gCtx *gin.Context) {
 		stat.MarkErr()
 		return
 	}
-	response, err := app.Query(context.Background(), request)
+	format := warehouse.FormatJSON
+	if gCtx.Query("raw") == "true" {
+		format = warehouse.FormatRawJSON
+	}
+	// the request context is done when the client goes away
+	response, pages, err := app.query(gCtx.Request.Context(), request, format)
+	if err != nil {
+		stat.MarkErr()
+		return
+	}
+	if response == nil || pages == nil {
+		gCtx.JSON(http.StatusOK, response)
+		return
+	}
+	data := make([]*jsonData, len(pages))
+	for i := 0; i < len(pages); i++ {
+		data[i] = &jsonData{Items: pages[i]}
+	}
+	gCtx.JSON(http.StatusOK, &jsonResponse{Response: response, Data: data})
+}
+
+// QueryStreamHandler writes the documents found as newline delimited json,
+// with chunked transfer encoding and a flush after every page. The token
+// which resumes the query, base64 encoded, and whether every shard is
+// finished come in the Disgorge-Token and Disgorge-Done trailers. A query
+// which fails before anything is written is answered with a 500.
+func (app *App) QueryStreamHandler(gCtx *gin.Context) {
+	stat := prome.NewStat("App.QueryStreamHandler")
+	defer stat.End()
+	request := &api.Request{}
+	if err := gCtx.ShouldBind(request); err != nil {
+		stat.MarkErr()
+		return
+	}
+	err := warehouse.QueryStream(gCtx.Request.Context(), request, warehouse.FormatNDJSON, ndjsonStream(gCtx))
 	if err != nil {
+		stat.MarkErr()
+		// once a page is out the status is sent, the missing trailers tell
+		// the stream is cut off
+		if !gCtx.Writer.Written() {
+			gCtx.AbortWithStatus(http.StatusInternalServerError)
+		}
+	}
+}
+
+// ndjsonStream writes the chunks of a QueryStream into the answer of
+// QueryStreamHandler: the pages as they are, and the final token in the
+// trailers
+func ndjsonStream(gCtx *gin.Context) func(*warehouse.Chunk) error {
+	gCtx.Header("Content-Type", "application/x-ndjson")
+	gCtx.Header("Trailer", "Disgorge-Token, Disgorge-Done")
+	return func(chunk *warehouse.Chunk) error {
+		// only a rejected token has another code, before anything is written
+		if chunk.Code != http.StatusOK {
+			gCtx.Status(int(chunk.Code))
+			return nil
+		}
+		if len(chunk.Body) > 0 {
+			if _, err := gCtx.Writer.Write(chunk.Body); err != nil {
+				return err
+			}
+			gCtx.Writer.Flush()
+			return nil
+		}
+		gCtx.Header("Disgorge-Token", base64.StdEncoding.EncodeToString(chunk.Token))
+		gCtx.Header("Disgorge-Done", strconv.FormatBool(chunk.Done))
+		return nil
+	}
+}
+
+func (app *App) MultiGet(ctx context.Context, in *api.MultiGetRequest) (*api.MultiGetResponse, error) {
+	stat := prome.NewStat("App.MultiGet")
+	defer stat.End()
+	response := warehouse.MultiGet(ctx, in)
+	if err := ctx.Err(); err != nil {
+		stat.MarkErr()
+		return nil, err
+	}
+	return response, nil
+}
+
+func (app *App) MultiGetHandler(gCtx *gin.Context) {
+	stat := prome.NewStat("App.MultiGetHandler")
+	defer stat.End()
+	request := &api.MultiGetRequest{}
+	if err := gCtx.ShouldBind(request); err != nil {
+		stat.MarkErr()
+		return
+	}
+	response, err := app.MultiGet(gCtx.Request.Context(), request)
+	if err != nil {
+		stat.MarkErr()
+		return
+	}
+	gCtx.JSON(http.StatusOK, response)
+}
+
+func (app *App) CreateSet(ctx context.Context, in *api.SetRequest) (*api.SetResponse, error) {
+	stat := prome.NewStat("App.CreateSet")
+	defer stat.End()
+	return warehouse.CreateSet(ctx, in), nil
+}
+
+func (app *App) CreateSetHandler(gCtx *gin.Context) {
+	stat := prome.NewStat("App.CreateSetHandler")
+	defer stat.End()
+	request := &api.SetRequest{}
+	if err := gCtx.ShouldBind(request); err != nil {
+		stat.MarkErr()
+		return
+	}
+	response, _ := app.CreateSet(gCtx.Request.Context(), request)
+	gCtx.JSON(http.StatusOK, response)
+}
+
+func (app *App) DropSet(ctx context.Context, in *api.DropSetRequest) (*api.SetResponse, error) {
+	stat := prome.NewStat("App.DropSet")
+	defer stat.End()
+	return warehouse.DropSet(ctx, in), nil
+}
+
+func (app *App) DropSetHandler(gCtx *gin.Context) {
+	stat := prome.NewStat("App.DropSetHandler")
+	defer stat.End()
+	request := &api.DropSetRequest{}
+	if err := gCtx.ShouldBind(request); err != nil {
 		stat.MarkErr()
 		return
 	}
+	response, _ := app.DropSet(gCtx.Request.Context(), request)
 	gCtx.JSON(http.StatusOK, response)
 }
 
@@ -0,0 +1,59 @@
+package app
+
+import (
+	"disgorge/warehouse"
+	"encoding/base64"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+
+	"github.com/gin-gonic/gin"
+)
+
+func TestNDJSONStream(t *testing.T) {
+	w := httptest.NewRecorder()
+	gCtx, _ := gin.CreateTestContext(w)
+	send := ndjsonStream(gCtx)
+	chunks := []*warehouse.Chunk{
+		{Code: 200, Path: "/data/a/1700000000", Body: []byte("{\"a\": 1}\n{\"a\": 2}\n"), Rows: 2},
+		// a page without values writes nothing
+		{Code: 200, Path: "/data/a/1700003600"},
+		{Code: 200, Path: "/data/b/1700003600", Body: []byte("{\"b\": 1}\n"), Rows: 1},
+		{Code: 200, Token: []byte{3, 0, 1}, Done: true},
+	}
+	for _, chunk := range chunks {
+		if err := send(chunk); err != nil {
+			t.Fatal(err)
+		}
+	}
+	gCtx.Writer.WriteHeaderNow()
+
+	res := w.Result()
+	if res.StatusCode != http.StatusOK || res.Header.Get("Content-Type") != "application/x-ndjson" {
+		t.Fatalf("status %d, content type %q", res.StatusCode, res.Header.Get("Content-Type"))
+	}
+	if body := w.Body.String(); body != "{\"a\": 1}\n{\"a\": 2}\n{\"b\": 1}\n" {
+		t.Fatalf("body %q", body)
+	}
+	if !w.Flushed {
+		t.Fatal("pages not flushed")
+	}
+	if got := res.Trailer.Get("Disgorge-Token"); got != base64.StdEncoding.EncodeToString([]byte{3, 0, 1}) {
+		t.Fatalf("token trailer %q", got)
+	}
+	if got := res.Trailer.Get("Disgorge-Done"); got != "true" {
+		t.Fatalf("done trailer %q", got)
+	}
+}
+
+func TestNDJSONStream_RejectedToken(t *testing.T) {
+	w := httptest.NewRecorder()
+	gCtx, _ := gin.CreateTestContext(w)
+	if err := ndjsonStream(gCtx)(&warehouse.Chunk{Code: http.StatusConflict}); err != nil {
+		t.Fatal(err)
+	}
+	gCtx.Writer.WriteHeaderNow()
+	if res := w.Result(); res.StatusCode != http.StatusConflict || w.Body.Len() != 0 {
+		t.Fatalf("status %d, body %q", res.StatusCode, w.Body.String())
+	}
+}
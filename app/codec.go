@@ -0,0 +1,89 @@
+package app
+
+import (
+	"context"
+	"encoding/binary"
+	"fmt"
+
+	"github.com/golang/protobuf/proto"
+	"google.golang.org/grpc"
+	"google.golang.org/grpc/encoding"
+)
+
+// dataField is the number of the data field of api.Response and api.Chunk
+const dataField = 3
+
+// encoded is a message whose data, the api.Data of each page, libdisgorge
+// already encoded. It is marshalled as the message without its data
+// followed by the pages as the data field: the elements of a repeated field
+// may come after the other fields, in their own order, so it reads back as
+// the message with its data.
+type encoded struct {
+	msg   proto.Message
+	pages [][]byte
+}
+
+// codec is the proto codec of the server, which sends encoded messages
+// without decoding their pages
+type codec struct{}
+
+func (codec) Marshal(v interface{}) ([]byte, error) {
+	e, ok := v.(*encoded)
+	if !ok {
+		msg, ok := v.(proto.Message)
+		if !ok {
+			return nil, fmt.Errorf("codec: %T is not a proto.Message", v)
+		}
+		return proto.Marshal(msg)
+	}
+	buf, err := proto.Marshal(e.msg)
+	if err != nil {
+		return nil, err
+	}
+	var tmp [binary.MaxVarintLen64]byte
+	for _, page := range e.pages {
+		n := binary.PutUvarint(tmp[:], dataField<<3|2)
+		buf = append(buf, tmp[:n]...)
+		n = binary.PutUvarint(tmp[:], uint64(len(page)))
+		buf = append(buf, tmp[:n]...)
+		buf = append(buf, page...)
+	}
+	return buf, nil
+}
+
+func (codec) Unmarshal(data []byte, v interface{}) error {
+	msg, ok := v.(proto.Message)
+	if !ok {
+		return fmt.Errorf("codec: %T is not a proto.Message", v)
+	}
+	return proto.Unmarshal(data, msg)
+}
+
+func (codec) Name() string {
+	return "proto"
+}
+
+var _ encoding.Codec = codec{}
+
+// pagesKey holds, in the context of a unary call, where its handler leaves
+// the encoded pages of its response
+type pagesKey struct{}
+
+// encodePages has the response of a unary call sent with the pages its
+// handler left in the context, if any
+func encodePages(ctx context.Context, req interface{}, info *grpc.UnaryServerInfo, handler grpc.UnaryHandler) (interface{}, error) {
+	var pages [][]byte
+	resp, err := handler(context.WithValue(ctx, pagesKey{}, &pages), req)
+	if err != nil || pages == nil {
+		return resp, err
+	}
+	return &encoded{msg: resp.(proto.Message), pages: pages}, nil
+}
+
+// ServerOptions are the options the grpc server of the app needs
+func (app *App) ServerOptions() []grpc.ServerOption {
+	return []grpc.ServerOption{
+		grpc.ForceServerCodec(codec{}),
+		grpc.UnaryInterceptor(encodePages),
+	}
+}
@@ -0,0 +1,110 @@
+package app
+
+import (
+	"bytes"
+	"disgorge/api"
+	"disgorge/warehouse"
+	"reflect"
+	"testing"
+)
+
+func encodeData(t *testing.T, items []string) []byte {
+	data := &api.Data{Items: items}
+	page, err := data.Marshal()
+	if err != nil {
+		t.Fatal(err)
+	}
+	return page
+}
+
+func TestCodec_EncodedResponse(t *testing.T) {
+	want := [][]string{{`{"a": 1}`, `{"a": 2}`}, {}, {`{"b": 1}`}}
+	pages := make([][]byte, len(want))
+	for i := 0; i < len(want); i++ {
+		pages[i] = encodeData(t, want[i])
+	}
+	msg := &api.Response{
+		Code:   200,
+		Shards: []*api.Shard{{Path: "/data/a/1700000000", Status: api.ShardStatus_InProgress, Lastkey: []byte("u1|1700000001")}},
+		Token:  []byte{3, 1, 2},
+	}
+	buf, err := codec{}.Marshal(&encoded{msg: msg, pages: pages})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	var got api.Response
+	if err := (codec{}).Unmarshal(buf, &got); err != nil {
+		t.Fatal(err)
+	}
+	if got.Code != 200 || len(got.Shards) != 1 || got.Shards[0].Path != msg.Shards[0].Path ||
+		!bytes.Equal(got.Shards[0].Lastkey, msg.Shards[0].Lastkey) || !bytes.Equal(got.Token, msg.Token) {
+		t.Fatalf("fields: %v", &got)
+	}
+	// the pages come back as the data of the response, one per shard, in order
+	if len(got.Data) != len(want) {
+		t.Fatalf("%d pages, want %d", len(got.Data), len(want))
+	}
+	for i := 0; i < len(want); i++ {
+		if len(got.Data[i].Items) != len(want[i]) || (len(want[i]) > 0 && !reflect.DeepEqual(got.Data[i].Items, want[i])) {
+			t.Fatalf("page %d: %q, want %q", i, got.Data[i].Items, want[i])
+		}
+	}
+}
+
+func TestCodec_EncodedChunk(t *testing.T) {
+	items := []string{`{"a": 1}`}
+	buf, err := codec{}.Marshal(&encoded{msg: &api.Chunk{Code: 200, Path: "/data/a/1700000000"}, pages: [][]byte{encodeData(t, items)}})
+	if err != nil {
+		t.Fatal(err)
+	}
+	var got api.Chunk
+	if err := (codec{}).Unmarshal(buf, &got); err != nil {
+		t.Fatal(err)
+	}
+	if got.Code != 200 || got.Path != "/data/a/1700000000" || got.Data == nil || !reflect.DeepEqual(got.Data.Items, items) {
+		t.Fatalf("chunk: %v", &got)
+	}
+}
+
+// the last chunk of a stream comes without data
+func TestCodec_LastChunk(t *testing.T) {
+	buf, err := codec{}.Marshal(encodeChunk(&warehouse.Chunk{Code: 200, Token: []byte{3, 1}, Done: true}))
+	if err != nil {
+		t.Fatal(err)
+	}
+	var got api.Chunk
+	if err := (codec{}).Unmarshal(buf, &got); err != nil {
+		t.Fatal(err)
+	}
+	if got.Code != 200 || got.Data != nil || !got.Done || !bytes.Equal(got.Token, []byte{3, 1}) {
+		t.Fatalf("chunk: %v", &got)
+	}
+
+	items := []string{`{"a": 1}`}
+	chunk := &warehouse.Chunk{Code: 200, Path: "/data/a/1700000000", Body: encodeData(t, items), Rows: 1}
+	if buf, err = (codec{}).Marshal(encodeChunk(chunk)); err != nil {
+		t.Fatal(err)
+	}
+	if err := (codec{}).Unmarshal(buf, &got); err != nil {
+		t.Fatal(err)
+	}
+	if got.Data == nil || !reflect.DeepEqual(got.Data.Items, items) || got.Done {
+		t.Fatalf("chunk: %v", &got)
+	}
+}
+
+func TestCodec_PlainMessage(t *testing.T) {
+	msg := &api.MultiGetResponse{Code: 200, Values: []string{"", "{}"}, Found: []bool{false, true}}
+	buf, err := codec{}.Marshal(msg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	var got api.MultiGetResponse
+	if err := (codec{}).Unmarshal(buf, &got); err != nil {
+		t.Fatal(err)
+	}
+	if !reflect.DeepEqual(got.Values, msg.Values) || !reflect.DeepEqual(got.Found, msg.Found) {
+		t.Fatalf("got %v, want %v", &got, msg)
+	}
+}
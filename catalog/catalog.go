@@ -0,0 +1,195 @@
+// Package catalog keeps the shard directories of the work dir in memory,
+// sorted by the hour they cover, so that a query finds its shards without
+// walking the tree. The tree is rescanned when inotify reports a change to
+// it, and periodically for the changes a watch does not see, e.g. on
+// network disks or where there is no inotify.
+package catalog
+
+import (
+	"os"
+	"path"
+	"sort"
+	"strconv"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+const success = "SUCCESS"
+
+const defaultRescan = time.Minute
+
+// settle lets a burst of changes, e.g. a shard being moved in, pass before
+// the rescan
+const settle = 200 * time.Millisecond
+
+// Shard is a <workdir>/<ip>/<ts> directory, which covers [Ts, Ts+interval)
+type Shard struct {
+	Path string
+	Ts   int64
+	// the SUCCESS marker is there once the shard is compacted
+	Ready bool
+}
+
+// snapshot is the tree as of one scan, the shards sorted by Ts then Path
+type snapshot struct {
+	shards []Shard
+	err    error
+}
+
+// Catalog answers which shards cover a time range from memory
+type Catalog struct {
+	workdir  string
+	interval int64
+	current  atomic.Value
+	watcher  *watcher
+	dirty    chan struct{}
+	stop     chan struct{}
+	once     sync.Once
+}
+
+// New scans workdir, where every shard covers `interval` seconds, and keeps
+// the catalog up to date until Close; rescan <= 0 rescans every minute
+func New(workdir string, interval int64, rescan time.Duration) *Catalog {
+	if rescan <= 0 {
+		rescan = defaultRescan
+	}
+	c := &Catalog{
+		workdir:  workdir,
+		interval: interval,
+		dirty:    make(chan struct{}, 1),
+		stop:     make(chan struct{}),
+	}
+	// without a watch the periodic rescans still catch up
+	c.watcher, _ = newWatcher(c.changed)
+	c.Rescan()
+	go c.run(rescan)
+	return c
+}
+
+// Close stops watching the tree, the catalog keeps its last scan
+func (c *Catalog) Close() {
+	c.once.Do(func() {
+		close(c.stop)
+		c.watcher.close()
+	})
+}
+
+// Watching tells whether changes are seen as they happen, rather than at
+// the next periodic rescan
+func (c *Catalog) Watching() bool {
+	return c.watcher != nil
+}
+
+// Shards are all the shards, sorted by Ts then Path; the slice is shared
+// and must not be modified
+func (c *Catalog) Shards() ([]Shard, error) {
+	s := c.current.Load().(*snapshot)
+	return s.shards, s.err
+}
+
+// Overlapping are the shards covering some of [start, end], sorted like
+// Shards and shared the same way. All the shards cover the same length of
+// time, so they are the ones starting in (start-interval, end], found by two
+// binary searches.
+func (c *Catalog) Overlapping(start, end int64) ([]Shard, error) {
+	s := c.current.Load().(*snapshot)
+	if s.err != nil || end < start {
+		return nil, s.err
+	}
+	lo := sort.Search(len(s.shards), func(i int) bool {
+		return s.shards[i].Ts > start-c.interval
+	})
+	hi := sort.Search(len(s.shards), func(i int) bool {
+		return s.shards[i].Ts > end
+	})
+	if lo >= hi {
+		return nil, nil
+	}
+	return s.shards[lo:hi:hi], nil
+}
+
+// Rescan reads the tree again and swaps the result in
+func (c *Catalog) Rescan() {
+	shards, dirs, err := scan(c.workdir)
+	if err == nil {
+		c.watcher.watch(dirs)
+	}
+	c.current.Store(&snapshot{shards: shards, err: err})
+}
+
+func (c *Catalog) changed() {
+	select {
+	case c.dirty <- struct{}{}:
+	default:
+	}
+}
+
+func (c *Catalog) run(rescan time.Duration) {
+	ticker := time.NewTicker(rescan)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-c.stop:
+			return
+		case <-ticker.C:
+		case <-c.dirty:
+			time.Sleep(settle)
+			select {
+			case <-c.dirty:
+			default:
+			}
+		}
+		c.Rescan()
+	}
+}
+
+// scan lists the shards of workdir, and the directories to watch: workdir,
+// the host directories and the shards which are not compacted yet
+func scan(workdir string) ([]Shard, []string, error) {
+	files, err := os.ReadDir(workdir)
+	if err != nil {
+		return nil, nil, err
+	}
+
+	shards := make([]Shard, 0)
+	dirs := []string{workdir}
+	for i := 0; i < len(files); i++ {
+		if !files[i].IsDir() {
+			continue
+		}
+
+		ipPath := path.Join(workdir, files[i].Name())
+		subFiles, err := os.ReadDir(ipPath)
+		if err != nil {
+			continue
+		}
+		dirs = append(dirs, ipPath)
+
+		for j := 0; j < len(subFiles); j++ {
+			if !subFiles[j].IsDir() {
+				continue
+			}
+
+			ts, err := strconv.ParseInt(subFiles[j].Name(), 10, 64)
+			if err != nil {
+				continue
+			}
+
+			shardPath := path.Join(ipPath, subFiles[j].Name())
+			_, err = os.Stat(path.Join(shardPath, success))
+			ready := !os.IsNotExist(err)
+			if !ready {
+				dirs = append(dirs, shardPath)
+			}
+			shards = append(shards, Shard{Path: shardPath, Ts: ts, Ready: ready})
+		}
+	}
+	sort.Slice(shards, func(a, b int) bool {
+		if shards[a].Ts != shards[b].Ts {
+			return shards[a].Ts < shards[b].Ts
+		}
+		return shards[a].Path < shards[b].Path
+	})
+	return shards, dirs, nil
+}
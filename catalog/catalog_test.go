@@ -0,0 +1,118 @@
+package catalog
+
+import (
+	"os"
+	"path"
+	"strconv"
+	"testing"
+	"time"
+)
+
+func mkShard(t *testing.T, dir, host string, ts int64, ready bool) string {
+	shardPath := path.Join(dir, host, strconv.FormatInt(ts, 10))
+	if err := os.MkdirAll(shardPath, 0755); err != nil {
+		t.Fatal(err)
+	}
+	if ready {
+		if err := os.WriteFile(path.Join(shardPath, success), nil, 0644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	return shardPath
+}
+
+func tss(shards []Shard) []int64 {
+	ret := make([]int64, len(shards))
+	for i := 0; i < len(shards); i++ {
+		ret[i] = shards[i].Ts
+	}
+	return ret
+}
+
+func equal(a, b []int64) bool {
+	if len(a) != len(b) {
+		return false
+	}
+	for i := 0; i < len(a); i++ {
+		if a[i] != b[i] {
+			return false
+		}
+	}
+	return true
+}
+
+func TestCatalog_Overlapping(t *testing.T) {
+	dir := t.TempDir()
+	for ts := int64(0); ts < 5*3600; ts += 3600 {
+		mkShard(t, dir, "a", ts, true)
+	}
+	mkShard(t, dir, "b", 3600, false)
+	if err := os.WriteFile(path.Join(dir, "a", "notes"), nil, 0644); err != nil {
+		t.Fatal(err)
+	}
+
+	c := New(dir, 3600, time.Hour)
+	defer c.Close()
+
+	cases := []struct {
+		start, end int64
+		want       []int64
+	}{
+		{0, 0, []int64{0}},
+		{3599, 3600, []int64{0, 3600, 3600}},
+		{3600, 3600, []int64{3600, 3600}},
+		// the shards lying inside a long range
+		{100, 4*3600 + 1, []int64{0, 3600, 3600, 7200, 10800, 14400}},
+		{5 * 3600, 6 * 3600, []int64{}},
+		{-3600, -1, []int64{}},
+	}
+	for _, tc := range cases {
+		got, err := c.Overlapping(tc.start, tc.end)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !equal(tss(got), tc.want) {
+			t.Fatalf("[%d, %d]: got %v, want %v", tc.start, tc.end, tss(got), tc.want)
+		}
+	}
+
+	got, _ := c.Overlapping(3600, 3600)
+	if got[0].Path != path.Join(dir, "a", "3600") || !got[0].Ready || got[1].Ready {
+		t.Fatalf("got %v", got)
+	}
+}
+
+func TestCatalog_Changes(t *testing.T) {
+	dir := t.TempDir()
+	mkShard(t, dir, "a", 0, false)
+	c := New(dir, 3600, time.Hour)
+	defer c.Close()
+
+	mkShard(t, dir, "a", 0, true)
+	mkShard(t, dir, "b", 3600, false)
+	if !c.Watching() {
+		c.Rescan()
+	}
+	deadline := time.Now().Add(5 * time.Second)
+	for {
+		shards, err := c.Shards()
+		if err != nil {
+			t.Fatal(err)
+		}
+		if len(shards) == 2 && shards[0].Ready {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("changes not seen: %v", shards)
+		}
+		time.Sleep(10 * time.Millisecond)
+	}
+}
+
+func TestCatalog_Missing(t *testing.T) {
+	c := New(path.Join(t.TempDir(), "missing"), 3600, time.Hour)
+	defer c.Close()
+	if _, err := c.Overlapping(0, 3600); err == nil {
+		t.Fatal("expected an error")
+	}
+}
@@ -0,0 +1,115 @@
+//go:build linux
+
+package catalog
+
+import (
+	"bytes"
+	"os"
+	"sync"
+	"syscall"
+	"unsafe"
+
+	"github.com/uopensail/ulib/zlog"
+	"go.uber.org/zap"
+)
+
+const watchMask = syscall.IN_CREATE | syscall.IN_DELETE | syscall.IN_MOVED_FROM |
+	syscall.IN_MOVED_TO | syscall.IN_ONLYDIR
+
+// watcher reports the changes to the tree through inotify: directories
+// coming and going, and SUCCESS markers showing up
+type watcher struct {
+	fd   int
+	file *os.File
+	mu   sync.Mutex
+	// the watch descriptor of each watched directory
+	watches map[string]int
+	// the directories which could not be watched, logged once
+	failed map[string]bool
+}
+
+func newWatcher(changed func()) (*watcher, error) {
+	fd, err := syscall.InotifyInit1(syscall.IN_NONBLOCK | syscall.IN_CLOEXEC)
+	if err != nil {
+		return nil, err
+	}
+	// nonblocking, so reads park on the netpoller
+	w := &watcher{
+		fd:      fd,
+		file:    os.NewFile(uintptr(fd), "inotify"),
+		watches: make(map[string]int),
+		failed:  make(map[string]bool),
+	}
+	go w.run(changed)
+	return w, nil
+}
+
+// watch has exactly dirs watched: the new ones get a watch, the ones which
+// are not there any more lose theirs, e.g. a shard once its SUCCESS marker
+// is there, so the watches stay well below max_user_watches. A directory
+// already watched keeps its watch, one which was removed and made again
+// gets a new one.
+func (w *watcher) watch(dirs []string) {
+	if w == nil {
+		return
+	}
+	w.mu.Lock()
+	defer w.mu.Unlock()
+
+	keep := make(map[string]bool, len(dirs))
+	for i := 0; i < len(dirs); i++ {
+		keep[dirs[i]] = true
+		wd, err := syscall.InotifyAddWatch(w.fd, dirs[i], watchMask)
+		if err != nil {
+			// the periodic rescans still see the changes to it
+			if !w.failed[dirs[i]] {
+				zlog.LOG.Warn("fail to watch shard directory", zap.String("path", dirs[i]), zap.Error(err))
+				w.failed[dirs[i]] = true
+			}
+			continue
+		}
+		delete(w.failed, dirs[i])
+		w.watches[dirs[i]] = wd
+	}
+	for dir, wd := range w.watches {
+		if keep[dir] {
+			continue
+		}
+		// the watch of a removed directory is already gone
+		_, _ = syscall.InotifyRmWatch(w.fd, uint32(wd))
+		delete(w.watches, dir)
+	}
+	for dir := range w.failed {
+		if !keep[dir] {
+			delete(w.failed, dir)
+		}
+	}
+}
+
+func (w *watcher) close() {
+	if w == nil {
+		return
+	}
+	w.file.Close()
+}
+
+func (w *watcher) run(changed func()) {
+	buf := make([]byte, 64*1024)
+	for {
+		n, err := w.file.Read(buf)
+		if err != nil {
+			return
+		}
+		for off := 0; off+syscall.SizeofInotifyEvent <= n; {
+			event := (*syscall.InotifyEvent)(unsafe.Pointer(&buf[off]))
+			off += syscall.SizeofInotifyEvent
+			name := bytes.TrimRight(buf[off:off+int(event.Len)], "\x00")
+			off += int(event.Len)
+			// the files a shard is written with do not matter
+			if event.Mask&(syscall.IN_ISDIR|syscall.IN_Q_OVERFLOW) != 0 ||
+				string(name) == success {
+				changed()
+			}
+		}
+	}
+}
@@ -0,0 +1,34 @@
+//go:build linux
+
+package catalog
+
+import (
+	"testing"
+	"time"
+)
+
+func TestCatalog_ReadyUnwatched(t *testing.T) {
+	dir := t.TempDir()
+	shardPath := mkShard(t, dir, "a", 0, false)
+	c := New(dir, 3600, time.Hour)
+	defer c.Close()
+	if !c.Watching() {
+		t.Skip("no inotify")
+	}
+
+	// workdir and the host directory stay watched
+	watched := func() (bool, int) {
+		c.watcher.mu.Lock()
+		defer c.watcher.mu.Unlock()
+		_, ok := c.watcher.watches[shardPath]
+		return ok, len(c.watcher.watches)
+	}
+	if ok, n := watched(); !ok || n != 3 {
+		t.Fatalf("shard in progress not watched: %v %d", ok, n)
+	}
+	mkShard(t, dir, "a", 0, true)
+	c.Rescan()
+	if ok, n := watched(); ok || n != 2 {
+		t.Fatalf("ready shard still watched: %v %d", ok, n)
+	}
+}
@@ -0,0 +1,16 @@
+//go:build !linux
+
+package catalog
+
+import "errors"
+
+// watcher is inotify on linux, elsewhere the periodic rescans do
+type watcher struct{}
+
+func newWatcher(changed func()) (*watcher, error) {
+	return nil, errors.New("catalog: no inotify")
+}
+
+func (w *watcher) watch(dirs []string) {}
+
+func (w *watcher) close() {}
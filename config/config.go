@@ -10,7 +10,15 @@ import (
 type AppConfig struct {
 	commonconfig.ServerConfig `json:",inline" toml:",inline"`
 	WorkDir                   string `json:"work_dir" toml:"work_dir"`
+	CatalogRescan             int    `json:"catalog_rescan" toml:"catalog_rescan"`
+	BlockCacheSize            int    `json:"block_cache_size" toml:"block_cache_size"`
 	LogDir                    string `json:"log_dir" toml:"log_dir"`
+	ScanParallelism           int    `json:"scan_parallelism" toml:"scan_parallelism"`
+	ScanThreads               int    `json:"scan_threads" toml:"scan_threads"`
+	QueryConcurrency          int    `json:"query_concurrency" toml:"query_concurrency"`
+	CursorIdleTimeout         int    `json:"cursor_idle_timeout" toml:"cursor_idle_timeout"`
+	MaxCursors                int    `json:"max_cursors" toml:"max_cursors"`
+	KeySchema                 string `json:"key_schema" toml:"key_schema"`
 }
 
 func (config *AppConfig) Init(configPath string) {
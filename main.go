@@ -3,6 +3,7 @@ package main
 import (
 	"disgorge/app"
 	"disgorge/config"
+	"disgorge/warehouse"
 	"flag"
 	"fmt"
 	"net"
@@ -21,16 +22,17 @@ import (
 func run(configFilePath string, logDir string) *app.App {
 	config.AppConf.Init(configFilePath)
 	zlog.InitLogger(config.AppConf.ProjectName, config.AppConf.Debug, logDir)
+	warehouse.Init()
 
 	app := app.NewApp()
-	runGRPC(app.GRPCAPIRegister)
+	runGRPC(app.GRPCAPIRegister, app.ServerOptions()...)
 	runHTTPServe(app.RegisterGinRouter)
 	return app
 }
 
-func runGRPC(registerFunc func(server *grpc.Server)) {
+func runGRPC(registerFunc func(server *grpc.Server), opts ...grpc.ServerOption) {
 	go func() {
-		grpcServer := grpc.NewServer()
+		grpcServer := grpc.NewServer(opts...)
 		registerFunc(grpcServer)
 		listener, err := net.Listen("tcp", fmt.Sprintf(":%d",
 			config.AppConf.ServerConfig.GRPCPort))
@@ -0,0 +1,196 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_ASYNC_HPP
+#define DISGORGE_ASYNC_HPP
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "response.hpp"
+
+namespace disgorge {
+
+const size_t default_async_threads = 4;
+
+// Completion is what a job hands back: its page and, for the scans which
+// registered one, the cursor the next pages continue from
+struct Completion {
+  uint64_t tag;
+  Response *resp;
+  uint64_t cursor;
+};
+
+// CompletionQueue runs scans on a bounded pool of its own threads, so that
+// a caller does not block a thread per scan in flight. Finished jobs queue
+// up until polled; the queue signals them through a pollable fd, an eventfd
+// on linux and a pipe elsewhere, which is readable once there are some.
+// Readers drain the fd, then poll until the queue is empty.
+class CompletionQueue {
+ public:
+  using Job = std::function<Completion()>;
+
+  CompletionQueue() = delete;
+  explicit CompletionQueue(size_t threads) : stop_(false) {
+#ifdef __linux__
+    read_fd_ = write_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (read_fd_ < 0) {
+      throw std::runtime_error("eventfd");
+    }
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+      throw std::runtime_error("pipe");
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+    for (int fd : fds) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if (threads == 0) {
+      threads = default_async_threads;
+    }
+    for (size_t i = 0; i < threads; i++) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  // the jobs already submitted still run, the pages nobody polled are freed
+  ~CompletionQueue() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+    for (auto &done : done_) {
+      delete done.resp;
+    }
+    close(read_fd_);
+    if (write_fd_ != read_fd_) {
+      close(write_fd_);
+    }
+  }
+
+  int fd() const { return read_fd_; }
+
+  // false once the queue is stopping
+  bool submit(uint64_t tag, Job job) {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      if (stop_) {
+        return false;
+      }
+      jobs_.emplace_back(tag, std::move(job));
+    }
+    cv_.notify_one();
+    return true;
+  }
+
+  // drops the job of `tag` if it has not started yet, in which case it never
+  // completes; false when it is running or done, its completion comes
+  bool cancel(uint64_t tag) {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto iter = jobs_.begin(); iter != jobs_.end(); ++iter) {
+      if (iter->first == tag) {
+        jobs_.erase(iter);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // false when no job has finished since the last poll
+  bool poll(Completion &done) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (done_.empty()) {
+      return false;
+    }
+    done = done_.front();
+    done_.pop_front();
+    return true;
+  }
+
+ private:
+  void work() {
+    for (;;) {
+      std::pair<uint64_t, Job> job;
+      {
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+          return;
+        }
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      Completion done{job.first, nullptr, 0};
+      try {
+        done = job.second();
+        done.tag = job.first;
+      } catch (...) {
+      }
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+        done_.push_back(done);
+      }
+      signal();
+    }
+  }
+
+  // a full pipe already wakes the reader, so a failed write is fine
+  void signal() {
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t n = write(write_fd_, &one, sizeof(one));
+#else
+    char one = 1;
+    ssize_t n = write(write_fd_, &one, sizeof(one));
+#endif
+    (void)n;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool stop_;
+  std::deque<std::pair<uint64_t, Job>> jobs_;
+  std::deque<Completion> done_;
+  std::vector<std::thread> workers_;
+  int read_fd_;
+  int write_fd_;
+};
+}  // namespace disgorge
+
+#endif  // DISGORGE_ASYNC_HPP
@@ -0,0 +1,267 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_CURSOR_HPP
+#define DISGORGE_CURSOR_HPP
+
+#pragma once
+
+#include <rocksdb/db.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "options.hpp"
+#include "pipeline.hpp"
+#include "planner.hpp"
+#include "query.hpp"
+#include "response.hpp"
+
+namespace disgorge {
+
+const int64_t default_cursor_idle_ms = 60 * 1000;
+const size_t default_max_cursors = 1024;
+
+static int64_t now_ms() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Cursor keeps a scan open between pages: the iterator stays positioned
+// after the last returned match, so the next page neither reopens the shard
+// nor seeks again. A page is only served to the scan the cursor was opened
+// for, and from the position of the page the cursor handed out last: a
+// caller which did not get that page (a retry, a cancelled request, an old
+// token) is refused and seeks from its own lastkey instead.
+class Cursor {
+ public:
+  Cursor() = delete;
+  // the scan starts after `after`, see Walk::seek_first
+  Cursor(std::shared_ptr<rocksdb::DB> db, std::shared_ptr<query::Boolean> expr,
+         const Plan &plan, rocksdb::Slice after,
+         const rocksdb::ReadOptions &options, const ScanOptions &scan_options)
+      : db_(db),
+        expr_(expr),
+        plan_(plan),
+        lower_(plan_.lower),
+        upper_(plan_.upper),
+        options_(options),
+        scan_options_(scan_options),
+        started_(false),
+        lastrange_(0),
+        last_used_(now_ms()) {
+    snapshot_ = db_->GetSnapshot();
+    options_.snapshot = snapshot_;
+    options_.iterate_lower_bound = lower_.size() > 0 ? &lower_ : nullptr;
+    options_.iterate_upper_bound = upper_.size() > 0 ? &upper_ : nullptr;
+    it_.reset(db_->NewIterator(options_));
+    estimate_skip(it_.get(), plan_);
+    walk_.reset(new Walk(it_.get(), plan_, scan_options_.reverse));
+    walk_->seek_first(after);
+  }
+  ~Cursor() {
+    walk_.reset();
+    it_.reset();
+    db_->ReleaseSnapshot(snapshot_);
+  }
+
+  // the limits and the budget of a page come from `page`, the profile and
+  // the parallelism are the ones the cursor was opened with. `lastkey` and
+  // `lastrange` are where the caller is, nullptr when the cursor is not
+  // there or `page` has another digest
+  Response *next(const ScanOptions &page, rocksdb::Slice lastkey,
+                 size_t lastrange) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (page.digest != scan_options_.digest ||
+        (started_ && (lastkey != lastkey_ || lastrange != lastrange_))) {
+      return nullptr;
+    }
+    last_used_.store(now_ms(), std::memory_order_relaxed);
+    Response *resp = new Response();
+    Collector collect =
+        resp->filler(page_rows(page.limit_rows), page.limit_bytes,
+                     page.request_page);
+    Budget budget(page.timeout_ms, page.max_keys, page.cancel);
+    rocksdb::Status status =
+        drain(*walk_, expr_, scan_options_, collect, budget);
+    resp->seal(budget, plan_, status);
+    if (resp->more_ == 1 && resp->lastkey_.empty()) {
+      // the page ended where it began, the caller stays there
+      if (scan_options_.parallelism > 1) {
+        if (lastkey.empty()) {
+          walk_->seek_first(lastkey);
+        } else {
+          walk_->seek_after(lastkey);
+        }
+      }
+      started_ = true;
+      lastkey_.assign(lastkey.data(), lastkey.size());
+      lastrange_ = lastrange;
+      last_used_.store(now_ms(), std::memory_order_relaxed);
+      return resp;
+    }
+    if (resp->more_ == 1) {
+      if (scan_options_.parallelism > 1) {
+        // the producer has read ahead of the last key consumed
+        walk_->seek_after(resp->lastkey_);
+      } else if (!resp->held_back_) {
+        walk_->next();
+      }
+    }
+    started_ = true;
+    lastkey_ = resp->lastkey_;
+    lastrange_ = resp->lastrange_;
+    last_used_.store(now_ms(), std::memory_order_relaxed);
+    return resp;
+  }
+
+  int64_t last_used() const {
+    return last_used_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::shared_ptr<rocksdb::DB> db_;
+  std::shared_ptr<query::Boolean> expr_;
+  Plan plan_;
+  rocksdb::Slice lower_;
+  rocksdb::Slice upper_;
+  rocksdb::ReadOptions options_;
+  const rocksdb::Snapshot *snapshot_;
+  std::unique_ptr<rocksdb::Iterator> it_;
+  std::unique_ptr<Walk> walk_;
+  ScanOptions scan_options_;
+  // the position of the last page handed out, the first page is served
+  // from where the cursor was opened
+  bool started_;
+  std::string lastkey_;
+  size_t lastrange_;
+  std::atomic<int64_t> last_used_;
+  std::mutex mu_;
+};
+
+// CursorRegistry hands out cursors by id, so that an id outliving its cursor
+// (idle timeout, eviction, another process) is detected rather than
+// dereferenced. Idle cursors are reaped whenever the registry is used, and
+// by `reap`, which the caller runs periodically so that a quiet process does
+// not keep their shards and snapshots open.
+class CursorRegistry {
+ public:
+  static CursorRegistry &instance() {
+    static CursorRegistry registry;
+    return registry;
+  }
+
+  void configure(int64_t idle_ms, size_t max_cursors) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (idle_ms > 0) {
+      idle_ms_ = idle_ms;
+    }
+    if (max_cursors > 0) {
+      max_cursors_ = max_cursors;
+    }
+  }
+
+  // 0 when the registry is full
+  uint64_t add(std::shared_ptr<Cursor> cursor) {
+    std::vector<std::shared_ptr<Cursor>> expired;
+    std::lock_guard<std::mutex> lock(mu_);
+    reap(expired);
+    if (cursors_.size() >= max_cursors_) {
+      return 0;
+    }
+    uint64_t id = next_id_++;
+    if (id == 0) {
+      id = next_id_++;
+    }
+    cursors_[id] = cursor;
+    return id;
+  }
+
+  std::shared_ptr<Cursor> get(uint64_t id) {
+    std::vector<std::shared_ptr<Cursor>> expired;
+    std::lock_guard<std::mutex> lock(mu_);
+    reap(expired);
+    auto iter = cursors_.find(id);
+    if (iter == cursors_.end()) {
+      return nullptr;
+    }
+    return iter->second;
+  }
+
+  // releases the cursors idle for longer than the idle timeout, returns how
+  // many
+  size_t reap() {
+    std::vector<std::shared_ptr<Cursor>> expired;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      reap(expired);
+    }
+    // released outside of the lock, closing the shard may take a while
+    return expired.size();
+  }
+
+  void remove(uint64_t id) {
+    std::shared_ptr<Cursor> cursor = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      auto iter = cursors_.find(id);
+      if (iter == cursors_.end()) {
+        return;
+      }
+      cursor = iter->second;
+      cursors_.erase(iter);
+    }
+    // released outside of the lock, closing the shard may take a while
+    cursor.reset();
+  }
+
+ private:
+  CursorRegistry()
+      : idle_ms_(default_cursor_idle_ms),
+        max_cursors_(default_max_cursors),
+        next_id_(std::mt19937_64(std::random_device{}())()) {}
+
+  // the expired cursors are handed to the caller, which releases them
+  // after the lock
+  void reap(std::vector<std::shared_ptr<Cursor>> &expired) {
+    int64_t now = now_ms();
+    for (auto iter = cursors_.begin(); iter != cursors_.end();) {
+      if (now - iter->second->last_used() > idle_ms_) {
+        expired.push_back(iter->second);
+        iter = cursors_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+ private:
+  std::mutex mu_;
+  int64_t idle_ms_;
+  size_t max_cursors_;
+  uint64_t next_id_;
+  std::unordered_map<uint64_t, std::shared_ptr<Cursor>> cursors_;
+};
+}  // namespace disgorge
+
+#endif  // DISGORGE_CURSOR_HPP
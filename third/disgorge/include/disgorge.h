@@ -21,20 +21,152 @@
 extern "C" {
 #endif
 
+// the capacity of the block cache all the shards share, before the first
+// disgorge_open
+void disgorge_block_cache_configure(unsigned long long capacity);
 void *disgorge_open(void *dir, unsigned long long len, void *secondary,
                     unsigned long long slen);
 void disgorge_close(void *ins);
 
+void *disgorge_new_scan_options();
+void disgorge_scan_options_set_profile(void *opts, int profile);
+void disgorge_scan_options_set_parallelism(void *opts,
+                                           unsigned long long parallelism);
+void disgorge_scan_options_set_reverse(void *opts, int reverse);
+void disgorge_scan_options_set_limits(void *opts, unsigned long long rows,
+                                      unsigned long long bytes);
+void disgorge_scan_options_set_budget(void *opts, unsigned long long timeout_ms,
+                                      unsigned long long max_keys);
+void disgorge_scan_options_set_cancel(void *opts, void *cancel);
+void disgorge_scan_options_set_digest(void *opts, unsigned long long digest);
+int disgorge_scan_options_set_key_schema(void *opts, void *schema,
+                                         unsigned long long len);
+void disgorge_del_scan_options(void *opts);
+
+// the page shared by the scans of one request, see RequestPage
+void disgorge_scan_options_set_request_page(void *opts, void *page);
+void *disgorge_new_request_page();
+void disgorge_del_request_page(void *page);
+void *disgorge_new_cancel();
+void disgorge_cancel(void *cancel);
+void disgorge_del_cancel(void *cancel);
+
 void *disgorge_scan(void *ins, void *query, unsigned long long qlen,
                     void *start, unsigned long long slen, void *end,
-                    unsigned long long elen);
+                    unsigned long long elen, void *opts);
+
+// range i is [bounds[2i], bounds[2i + 1]), bound j being
+// bounds[offsets[j], offsets[j + 1]); the ranges are sorted and coalesced,
+// and `range` and `lastkey` are the resume point of the previous page
+void *disgorge_scan_ranges(void *ins, void *query, unsigned long long qlen,
+                           void *bounds, const unsigned long long *offsets,
+                           unsigned long long n, unsigned long long range,
+                           void *lastkey, unsigned long long klen, void *opts);
+
+void *disgorge_multiget(void *ins, void *keys,
+                        const unsigned long long *offsets,
+                        unsigned long long n, void *opts);
+
+// the handle of a set of ids which queries reference with
+// `{"type": 18, "set": <handle>, "column": ...}`; value i of a string set is
+// values[offsets[i], offsets[i + 1]). 0 when the values of a string set take
+// more than 4 GiB
+unsigned long long disgorge_new_set(void *values,
+                                    const unsigned long long *offsets,
+                                    unsigned long long n);
+unsigned long long disgorge_new_int_set(const long long *values,
+                                        unsigned long long n);
+void disgorge_del_set(unsigned long long set);
 
 int disgorge_check_query(void *query, unsigned long long len);
 
+void disgorge_cursor_configure(unsigned long long idle_timeout_ms,
+                               unsigned long long max_cursors);
+unsigned long long disgorge_cursor_open(void *ins, void *query,
+                                        unsigned long long qlen, void *start,
+                                        unsigned long long slen, void *end,
+                                        unsigned long long elen, void *opts);
+unsigned long long disgorge_cursor_open_ranges(
+    void *ins, void *query, unsigned long long qlen, void *bounds,
+    const unsigned long long *offsets, unsigned long long n,
+    unsigned long long range, void *lastkey, unsigned long long klen,
+    void *opts);
+// null when the cursor is gone, was opened with another digest or is not at
+// lastkey/lastrange, the position of the page the caller got last
+void *disgorge_cursor_next(unsigned long long cursor, void *lastkey,
+                           unsigned long long klen, unsigned long long range,
+                           void *opts);
+void disgorge_cursor_close(unsigned long long cursor);
+// releases the idle cursors, to be called periodically; returns how many
+unsigned long long disgorge_cursor_reap();
+
+// scans run on the bounded pool of `threads` of a queue instead of the thread
+// of the caller. A job is submitted with a tag of the caller and its
+// completion is polled with that tag: the page, and for scans the cursor the
+// next pages continue from, 0 if none could be registered. The fd of the
+// queue is nonblocking and readable once some completions wait: drain it,
+// then poll until there are none. The instance, the cancel token and the
+// request page of a job must outlive its completion.
+void *disgorge_new_queue(unsigned long long threads);
+int disgorge_queue_fd(void *queue);
+int disgorge_queue_poll(void *queue, unsigned long long *tag, void **resp,
+                        unsigned long long *cursor);
+// 1 when the job of `tag` had not started and is dropped without a
+// completion, 0 when its completion comes
+int disgorge_queue_cancel(void *queue, unsigned long long tag);
+void disgorge_del_queue(void *queue);
+// disgorge_cursor_open_ranges then disgorge_cursor_next, or
+// disgorge_scan_ranges when no cursor can be registered
+int disgorge_submit_scan_ranges(void *queue, unsigned long long tag,
+                                void *ins, void *query,
+                                unsigned long long qlen, void *bounds,
+                                const unsigned long long *offsets,
+                                unsigned long long n, unsigned long long range,
+                                void *lastkey, unsigned long long klen,
+                                void *opts);
+// the page is null when disgorge_cursor_next would return null
+int disgorge_submit_cursor_next(void *queue, unsigned long long tag,
+                                unsigned long long cursor, void *lastkey,
+                                unsigned long long klen,
+                                unsigned long long range, void *opts);
+
 unsigned long long disgorge_response_size(void *resp);
+unsigned long long disgorge_response_bytes(void *resp);
 int disgorge_response_more(void *resp);
+// 0 when the scan stopped on a read error, or there is no page at all
+int disgorge_response_ok(void *resp);
+// the key may hold any byte, its length is disgorge_response_lastkey_len
 const char *disgorge_response_lastkey(void *resp);
+unsigned long long disgorge_response_lastkey_len(void *resp);
+unsigned long long disgorge_response_lastrange(void *resp);
 const char *disgorge_response_value(void *resp, unsigned long long index);
+unsigned long long disgorge_response_value_len(void *resp,
+                                               unsigned long long index);
+// one byte per value into `dst`, 0 where the key of a multiget was not
+// found and 1 otherwise; returns the bytes written, 0 if `cap` is too small
+unsigned long long disgorge_response_found(void *resp, void *dst,
+                                           unsigned long long cap);
+// the page framed as each value preceded by its length, 4 bytes little
+// endian, written into `dst` which the caller allocated with at least
+// disgorge_response_framed_size bytes; returns the bytes written, 0 if `cap`
+// is too small
+unsigned long long disgorge_response_framed_size(void *resp);
+unsigned long long disgorge_response_frame(void *resp, void *dst,
+                                           unsigned long long cap);
+// the page encoded the way the server answers it, written into `dst` like
+// disgorge_response_frame: the api.Data message in protobuf wire format, or
+// a json array of the values, which go in as json documents when `raw` and
+// as strings otherwise
+unsigned long long disgorge_response_data_size(void *resp);
+unsigned long long disgorge_response_data(void *resp, void *dst,
+                                          unsigned long long cap);
+unsigned long long disgorge_response_json_size(void *resp, int raw);
+unsigned long long disgorge_response_json(void *resp, void *dst,
+                                          unsigned long long cap, int raw);
+// the json documents one a line, newline delimited json
+unsigned long long disgorge_response_ndjson_size(void *resp);
+unsigned long long disgorge_response_ndjson(void *resp, void *dst,
+                                            unsigned long long cap);
 void disgorge_del_response(void *resp);
 
 #ifdef __cplusplus
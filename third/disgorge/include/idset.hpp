@@ -0,0 +1,166 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_IDSET_HPP
+#define DISGORGE_IDSET_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace query {
+
+// IdSet is a large immutable set of ids, e.g. the users of a cohort, which
+// queries test membership against with a binary search. The strings are kept
+// sorted back to back in one buffer, the integers in a sorted array.
+class IdSet {
+ public:
+  // the offsets of the strings are 32 bits
+  static constexpr size_t max_bytes = UINT32_MAX;
+
+  IdSet() = delete;
+  explicit IdSet(std::vector<std::string> values) : integer_(false) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    size_t bytes = 0;
+    for (auto &v : values) {
+      bytes += v.size();
+    }
+    buffer_.reserve(bytes);
+    offsets_.reserve(values.size() + 1);
+    offsets_.push_back(0);
+    for (auto &v : values) {
+      buffer_.append(v);
+      offsets_.push_back(buffer_.size());
+    }
+  }
+  explicit IdSet(std::vector<int64_t> values)
+      : integer_(true), integers_(std::move(values)) {
+    std::sort(integers_.begin(), integers_.end());
+    integers_.erase(std::unique(integers_.begin(), integers_.end()),
+                    integers_.end());
+    integers_.shrink_to_fit();
+  }
+  ~IdSet() = default;
+
+  bool integer() const { return integer_; }
+  size_t size() const {
+    return integer_ ? integers_.size() : offsets_.size() - 1;
+  }
+  // in ascending order
+  std::string_view str(size_t i) const {
+    return {buffer_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]};
+  }
+  int64_t integer(size_t i) const { return integers_[i]; }
+
+  bool contains(std::string_view v) const {
+    if (integer_) {
+      return false;
+    }
+    size_t lo = 0;
+    size_t hi = size();
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (str(mid) < v) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo < size() && str(lo) == v;
+  }
+  bool contains(int64_t v) const {
+    return integer_ &&
+           std::binary_search(integers_.begin(), integers_.end(), v);
+  }
+
+ private:
+  bool integer_;
+  std::string buffer_;
+  std::vector<uint32_t> offsets_;
+  std::vector<int64_t> integers_;
+};
+
+// IdSetRegistry holds the uploaded sets by handle, so that several queries,
+// pages and shards share one copy. A query holds on to the set it references,
+// dropping the handle does not pull it from under a running scan.
+class IdSetRegistry {
+ public:
+  static IdSetRegistry &instance() {
+    static IdSetRegistry registry;
+    return registry;
+  }
+
+  // handles stay below 2^53, so that they go through json numbers, which
+  // queries reference the set with, without losing precision
+  static constexpr uint64_t max_handle = (uint64_t(1) << 53) - 1;
+
+  uint64_t add(std::shared_ptr<const IdSet> set) {
+    std::lock_guard<std::mutex> lock(mu_);
+    uint64_t id = next_id_++ & max_handle;
+    if (id == 0) {
+      id = next_id_++ & max_handle;
+    }
+    sets_[id] = set;
+    return id;
+  }
+
+  std::shared_ptr<const IdSet> get(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto iter = sets_.find(id);
+    if (iter == sets_.end()) {
+      return nullptr;
+    }
+    return iter->second;
+  }
+
+  void remove(uint64_t id) {
+    std::shared_ptr<const IdSet> set = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      auto iter = sets_.find(id);
+      if (iter == sets_.end()) {
+        return;
+      }
+      set = iter->second;
+      sets_.erase(iter);
+    }
+    // a large set is freed outside of the lock
+    set.reset();
+  }
+
+ private:
+  // starts at random so that a handle of a previous process is unlikely to
+  // name a set of this one
+  IdSetRegistry()
+      : next_id_(std::mt19937_64(std::random_device{}())() & max_handle) {}
+
+ private:
+  std::mutex mu_;
+  uint64_t next_id_;
+  std::unordered_map<uint64_t, std::shared_ptr<const IdSet>> sets_;
+};
+}  // namespace query
+
+#endif  // DISGORGE_IDSET_HPP
@@ -19,108 +19,319 @@
 
 #pragma once
 
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
 #include <rocksdb/merge_operator.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
+#include <rocksdb/utilities/options_util.h>
 #include <rocksdb/write_batch.h>
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
+#include "cursor.hpp"
+#include "options.hpp"
+#include "pipeline.hpp"
+#include "planner.hpp"
 #include "query.hpp"
+#include "response.hpp"
 
 namespace disgorge {
 
-const size_t max_count = 1000;
+const size_t default_block_cache_size = 512 << 20;
 
-class Instance;
-
-class Response {
+// BlockCache is the one block cache of all the shards the process opens. An
+// instance only lives for a page, so a cache of its own would start cold
+// every time, and the bulk profile not filling it would protect nothing.
+class BlockCache {
  public:
-  Response() : more_(0), lastkey_("") {}
-  ~Response() = default;
-  int more() { return more_; }
-  size_t size() { return data_.size(); }
-  const std::string &lastkey() { return lastkey_; }
-  const std::string &operator[](size_t i) const { return data_[i]; }
+  static BlockCache &instance() {
+    static BlockCache cache;
+    return cache;
+  }
+
+  void configure(size_t capacity) {
+    if (capacity > 0) {
+      cache_->SetCapacity(capacity);
+    }
+  }
+
+  std::shared_ptr<rocksdb::Cache> get() const { return cache_; }
 
  private:
-  int more_;
-  std::string lastkey_;
-  std::vector<std::string> data_;
-  friend class Instance;
+  BlockCache() : cache_(rocksdb::NewLRUCache(default_block_cache_size)) {}
+
+  std::shared_ptr<rocksdb::Cache> cache_;
 };
 
 class Instance {
  public:
   Instance() = delete;
   Instance(std::string data_dir, std::string secondary = "") : db_(nullptr) {
+    rocksdb::Options opts = load_options(data_dir);
+    prefix_extractor_ = opts.prefix_extractor;
+    rocksdb::DB *db = nullptr;
     rocksdb::Status status;
     if (secondary != "") {
-      status = rocksdb::DB::OpenAsSecondary(rocksdb::Options(), data_dir,
-                                            secondary, &db_);
+      opts.max_open_files = -1;
+      status = rocksdb::DB::OpenAsSecondary(opts, data_dir, secondary, &db);
     } else {
-      status = rocksdb::DB::OpenForReadOnly(rocksdb::Options(), data_dir, &db_);
+      status = rocksdb::DB::OpenForReadOnly(opts, data_dir, &db);
     }
     if (!status.ok()) {
       std::cerr << "open leveldb error: " << status.ToString() << std::endl;
       throw std::runtime_error("open rocksdb error");
     }
-    assert(db_ != nullptr);
-  }
-  ~Instance() {
-    db_->Close();
-    delete db_;
+    assert(db != nullptr);
+    // cursors share the db, it is closed when the last of them is gone
+    db_ = std::shared_ptr<rocksdb::DB>(db, [](rocksdb::DB *db) {
+      db->Close();
+      delete db;
+    });
   }
+  ~Instance() = default;
 
+  // scans the keys in [start, end), an empty end is unbounded
   Response *scan(rocksdb::Slice query, rocksdb::Slice start,
-                 rocksdb::Slice end) {
-    std::shared_ptr<query::Boolean> expr = nullptr;
-    try {
-      expr = query::parse(query.data(), query.size());
-    } catch (...) {
+                 rocksdb::Slice end,
+                 const ScanOptions &scan_options = ScanOptions()) {
+    std::shared_ptr<query::Boolean> expr = compile(query);
+    if (expr == nullptr) {
       return nullptr;
     }
+    return scan(expr, plan(expr.get(), key_schema(scan_options), start, end),
+                rocksdb::Slice(), scan_options);
+  }
 
-    Response *resp = new Response();
-    rocksdb::ReadOptions options;
-    if (start.size() > 0) {
-      options.iterate_lower_bound = &start;
+  // scans several key ranges with one iterator, in any order and possibly
+  // overlapping; they are sorted and coalesced first. A page which stopped
+  // at `lastkey` in range `range` of the coalesced ranges resumes right
+  // after it, an empty `lastkey` starts from the beginning.
+  Response *scan(rocksdb::Slice query, const std::vector<KeyRange> &ranges,
+                 size_t range, rocksdb::Slice lastkey,
+                 const ScanOptions &scan_options = ScanOptions()) {
+    std::shared_ptr<query::Boolean> expr = compile(query);
+    if (expr == nullptr) {
+      return nullptr;
     }
+    return scan(expr,
+                range_plan(expr.get(), ranges, range, lastkey, scan_options),
+                lastkey, scan_options);
+  }
 
-    if (end.size() > 0) {
-      options.iterate_upper_bound = &end;
+  // batched point lookups: value i is the one of keys[i], empty and not
+  // found (see Response::found) when the key does not exist. The keys are
+  // looked up in sorted order, so that MultiGet reads every data block at
+  // most once.
+  Response *multiget(const std::vector<rocksdb::Slice> &keys,
+                     const ScanOptions &scan_options = ScanOptions()) {
+    size_t n = keys.size();
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](size_t a, size_t b) {
+      return keys[a].compare(keys[b]) < 0;
+    });
+    std::vector<rocksdb::Slice> sorted(n);
+    for (size_t i = 0; i < n; i++) {
+      sorted[i] = keys[order[i]];
     }
 
-    rocksdb::Iterator *it = db_->NewIterator(options);
-    it->SeekToFirst();
+    rocksdb::ReadOptions options;
+    apply_profile(scan_options.profile, options);
+    // reads the blocks of a batch concurrently where rocksdb is built with
+    // coroutines, and is ignored otherwise
+    options.async_io = true;
+    std::vector<rocksdb::PinnableSlice> values(n);
+    std::vector<rocksdb::Status> statuses(n);
+    db_->MultiGet(options, db_->DefaultColumnFamily(), n, sorted.data(),
+                  values.data(), statuses.data(), true);
 
-    if (it->Valid()) {
-      if (it->key() == start) {
-        it->Next();
+    std::vector<size_t> position(n);
+    for (size_t i = 0; i < n; i++) {
+      position[order[i]] = i;
+    }
+    Response *resp = new Response();
+    for (size_t i = 0; i < n; i++) {
+      size_t j = position[i];
+      if (statuses[j].ok()) {
+        resp->append(values[j]);
+      } else {
+        resp->miss();
       }
     }
-    size_t count = 0;
-    for (; it->Valid(); it->Next()) {
-      const json &doc =
-          json::parse(std::string_view{it->value().data(), it->value().size()});
-      if (expr->Exec(doc)) {
-        resp->data_.emplace_back(
-            std::string{it->value().data(), it->value().size()});
-        count++;
-        if (count >= max_count) {
-          resp->more_ = 1;
-          resp->lastkey_ = std::string{it->key().data(), it->key().size()};
-          break;
+    return resp;
+  }
+
+  // a cursor keeps the iterator, the compiled query and a snapshot between
+  // pages, nullptr if the query is invalid
+  std::shared_ptr<Cursor> open_cursor(
+      rocksdb::Slice query, rocksdb::Slice start, rocksdb::Slice end,
+      const ScanOptions &scan_options = ScanOptions()) {
+    std::shared_ptr<query::Boolean> expr = compile(query);
+    if (expr == nullptr) {
+      return nullptr;
+    }
+    Plan key_plan = plan(expr.get(), key_schema(scan_options), start, end);
+    return std::make_shared<Cursor>(
+        db_, expr, key_plan, rocksdb::Slice(),
+        read_options(key_plan, scan_options, expr.get()), scan_options);
+  }
+
+  // a cursor over several key ranges, see scan
+  std::shared_ptr<Cursor> open_cursor(
+      rocksdb::Slice query, const std::vector<KeyRange> &ranges, size_t range,
+      rocksdb::Slice lastkey, const ScanOptions &scan_options = ScanOptions()) {
+    std::shared_ptr<query::Boolean> expr = compile(query);
+    if (expr == nullptr) {
+      return nullptr;
+    }
+    Plan key_plan =
+        range_plan(expr.get(), ranges, range, lastkey, scan_options);
+    return std::make_shared<Cursor>(
+        db_, expr, key_plan, lastkey,
+        read_options(key_plan, scan_options, expr.get()), scan_options);
+  }
+
+ private:
+  static std::shared_ptr<query::Boolean> compile(rocksdb::Slice query) {
+    try {
+      return query::parse(query.data(), query.size());
+    } catch (...) {
+      return nullptr;
+    }
+  }
+
+  static Plan range_plan(query::Boolean *expr,
+                         const std::vector<KeyRange> &ranges, size_t range,
+                         rocksdb::Slice lastkey,
+                         const ScanOptions &scan_options) {
+    std::vector<KeyRange> requested = coalesce(ranges);
+    Plan ret = plan(expr, key_schema(scan_options),
+                    resume(requested, range, lastkey, scan_options.reverse));
+    ret.requested = requested;
+    return ret;
+  }
+
+  // scans the plan, starting after `after`
+  Response *scan(std::shared_ptr<query::Boolean> expr, Plan key_plan,
+                 rocksdb::Slice after, const ScanOptions &scan_options) {
+    Response *resp = new Response();
+    // the key predicates may narrow the scan to a few ranges
+    if (key_plan.ranged && key_plan.ranges.empty()) {
+      return resp;
+    }
+    rocksdb::Slice lower = key_plan.lower;
+    rocksdb::Slice upper = key_plan.upper;
+    rocksdb::ReadOptions options =
+        read_options(key_plan, scan_options, expr.get());
+    options.iterate_lower_bound = lower.size() > 0 ? &lower : nullptr;
+    options.iterate_upper_bound = upper.size() > 0 ? &upper : nullptr;
+
+    std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(options));
+    // the first page of a shard decides on the skip-scan, later ones keep
+    // the choice of the planner rather than sample the shard again: their
+    // seeks are bounded by the budget of the page either way
+    if (after.empty()) {
+      estimate_skip(it.get(), key_plan);
+    }
+    Walk walk(it.get(), key_plan, scan_options.reverse);
+    walk.seek_first(after);
+    Collector collect =
+        resp->filler(page_rows(scan_options.limit_rows),
+                     scan_options.limit_bytes, scan_options.request_page);
+    Budget budget(scan_options.timeout_ms, scan_options.max_keys,
+                  scan_options.cancel);
+    rocksdb::Status status =
+        drain(walk, expr, scan_options, collect, budget);
+    resp->seal(budget, key_plan, status);
+    return resp;
+  }
+
+  // use the options the writer persisted in the OPTIONS file, so that the
+  // prefix extractor and table filters match the ones used to build the sst;
+  // the block cache is the one of the process either way
+  static rocksdb::Options load_options(const std::string &data_dir) {
+    rocksdb::ConfigOptions config;
+    config.ignore_unknown_options = true;
+    rocksdb::DBOptions db_opts;
+    std::vector<rocksdb::ColumnFamilyDescriptor> cf_descs;
+    std::shared_ptr<rocksdb::Cache> cache = BlockCache::instance().get();
+    rocksdb::Status status = rocksdb::LoadLatestOptions(
+        config, data_dir, &db_opts, &cf_descs, &cache);
+    if (status.ok()) {
+      for (auto &desc : cf_descs) {
+        if (desc.name == rocksdb::kDefaultColumnFamilyName) {
+          return rocksdb::Options(db_opts, desc.options);
         }
       }
     }
-    delete it;
-    return resp;
+    rocksdb::Options opts;
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.block_cache = cache;
+    opts.table_factory.reset(
+        rocksdb::NewBlockBasedTableFactory(table_options));
+    return opts;
+  }
+
+  // everything but the bounds, which the caller points at its own copy of
+  // the bounds of the plan
+  rocksdb::ReadOptions read_options(const Plan &key_plan,
+                                    const ScanOptions &scan_options,
+                                    query::Boolean *expr) const {
+    rocksdb::ReadOptions options;
+    apply_profile(scan_options.profile, options);
+#if DISGORGE_LAZY_VALUE
+    // the key predicates run before the value is loaded
+    options.allow_unprepared_value = expr != nullptr && expr->uses_key();
+#endif
+    if (same_prefix(key_plan.lower, key_plan.upper)) {
+      // userId-scoped range: seek straight into the prefix and let the
+      // prefix bloom filters skip the sst files which do not contain it
+      options.prefix_same_as_start = true;
+    } else if (prefix_extractor_ != nullptr) {
+      options.auto_prefix_mode = true;
+    }
+    return options;
+  }
+
+  static void apply_profile(ScanProfile profile,
+                            rocksdb::ReadOptions &options) {
+    switch (profile) {
+      case kBulk:
+        options.fill_cache = false;
+        options.readahead_size = bulk_readahead_size;
+        options.async_io = true;
+        options.adaptive_readahead = true;
+        break;
+      case kInteractive:
+      default:
+        options.fill_cache = true;
+        options.readahead_size = interactive_readahead_size;
+        break;
+    }
+  }
+
+  bool same_prefix(const rocksdb::Slice &start,
+                   const rocksdb::Slice &end) const {
+    if (prefix_extractor_ == nullptr || start.size() == 0 || end.size() == 0) {
+      return false;
+    }
+    if (!prefix_extractor_->InDomain(start) ||
+        !prefix_extractor_->InDomain(end)) {
+      return false;
+    }
+    return prefix_extractor_->Transform(start) ==
+           prefix_extractor_->Transform(end);
   }
 
  private:
-  rocksdb::DB *db_;
+  std::shared_ptr<rocksdb::DB> db_;
+  std::shared_ptr<const rocksdb::SliceTransform> prefix_extractor_;
 };
 }  // namespace disgorge
 
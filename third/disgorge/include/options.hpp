@@ -0,0 +1,123 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_OPTIONS_HPP
+#define DISGORGE_OPTIONS_HPP
+
+#pragma once
+
+#include <rocksdb/version.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "query.hpp"
+
+// iterators can leave values unloaded until PrepareValue, so entries which
+// the key predicates reject are never read from the blob files
+#if ROCKSDB_MAJOR > 9 || (ROCKSDB_MAJOR == 9 && ROCKSDB_MINOR >= 4)
+#define DISGORGE_LAZY_VALUE 1
+#else
+#define DISGORGE_LAZY_VALUE 0
+#endif
+
+namespace disgorge {
+
+const size_t max_count = 1000;
+const size_t interactive_readahead_size = 32 * 1024;
+const size_t bulk_readahead_size = 4 * 1024 * 1024;
+
+enum ScanProfile : int {
+  // short userId-scoped lookups: keep the blocks hot in the cache
+  kInteractive = 0,
+  // exports: stream through the shard without evicting hot blocks
+  kBulk = 1,
+};
+
+// Cancel is tripped by the caller, e.g. when the client went away, and
+// checked by running scans, which then stop at the next check
+class Cancel {
+ public:
+  Cancel() : cancelled_(false) {}
+  ~Cancel() = default;
+  void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+  bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<bool> cancelled_;
+};
+
+// RequestPage is the page of a request whose shards are scanned at once,
+// each scan taking a share of its limits: only the first value of the whole
+// page may go over the byte limit, which is what paging needs to progress
+class RequestPage {
+ public:
+  RequestPage() : empty_(true) {}
+  ~RequestPage() = default;
+  void fill() { empty_.store(false, std::memory_order_relaxed); }
+  // true for the one scan that takes the first value of the page
+  bool claim() {
+    bool empty = true;
+    return empty_.compare_exchange_strong(empty, false,
+                                          std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<bool> empty_;
+};
+
+struct ScanOptions {
+  ScanProfile profile = kInteractive;
+  // number of parse/filter workers, 0 or 1 scans on the calling thread
+  size_t parallelism = 0;
+  // newest first: walk from the upper bound down to the lower one
+  bool reverse = false;
+  // page budget, the page ends at whichever limit is reached first;
+  // 0 rows means max_count, 0 bytes means no byte limit
+  size_t limit_rows = 0;
+  size_t limit_bytes = 0;
+  // work budget of a page, 0 means unbounded; once spent the page ends
+  // early and resumes after the last key examined
+  uint64_t timeout_ms = 0;
+  size_t max_keys = 0;
+  // not owned, must outlive the scan
+  const Cancel *cancel = nullptr;
+  // not owned, must outlive the scan; nullptr when the scan is the page
+  RequestPage *request_page = nullptr;
+  // decodes the keys for the key predicates, nullptr means
+  // query::default_key_schema
+  std::shared_ptr<const query::KeySchema> key_schema = nullptr;
+  // identifies the scan (query, ranges and direction) for the caller: a
+  // cursor only serves pages to the scan it was opened for
+  uint64_t digest = 0;
+};
+
+static const query::KeySchema &key_schema(const ScanOptions &scan_options) {
+  static const query::KeySchema schema(query::default_key_schema);
+  if (scan_options.key_schema != nullptr) {
+    return *scan_options.key_schema;
+  }
+  return schema;
+}
+
+static size_t page_rows(size_t limit_rows) {
+  return limit_rows > 0 ? limit_rows : max_count;
+}
+}  // namespace disgorge
+
+#endif  // DISGORGE_OPTIONS_HPP
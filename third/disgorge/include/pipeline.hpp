@@ -0,0 +1,700 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_PIPELINE_HPP
+#define DISGORGE_PIPELINE_HPP
+
+#pragma once
+
+#include <rocksdb/db.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "options.hpp"
+#include "planner.hpp"
+#include "query.hpp"
+
+namespace disgorge {
+
+const size_t pipeline_window = 1024;
+// the clock and the cancel token are read once every `budget_check_stride`
+// examined keys
+const size_t budget_check_stride = 32;
+// a thread of the pipeline yields this many times before it parks
+const size_t pipeline_spins = 64;
+
+// bounded lock-free multi-producer multi-consumer queue,
+// see: https://www.1024cores.net/home/lock-free-algorithms/queues
+template <typename T>
+class Ring {
+ public:
+  Ring() = delete;
+  explicit Ring(size_t capacity) : mask_(0) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    cells_.reset(new Cell[size]);
+    for (size_t i = 0; i < size; i++) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+  }
+  ~Ring() = default;
+
+  bool push(const T &data) {
+    Cell *cell;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = data;
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &data) {
+    Cell *cell;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    data = cell->data;
+    cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  alignas(64) std::atomic<size_t> enqueue_pos_;
+  alignas(64) std::atomic<size_t> dequeue_pos_;
+};
+
+// Parker lets threads wait for a condition on atomics: a waiter spins for a
+// little while, as the condition usually holds soon, then sleeps until
+// `notify`. Notifying is a load when nobody sleeps.
+class Parker {
+ public:
+  Parker() : sleepers_(0) {}
+  ~Parker() = default;
+
+  template <typename Ready>
+  void wait(Ready ready) {
+    for (size_t i = 0; i < pipeline_spins; i++) {
+      if (ready()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleepers_.fetch_add(1);
+    // pairs with the fence in notify: either the waiter sees the condition
+    // or the notifier sees the sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cond_.wait(lock, ready);
+    sleepers_.fetch_sub(1);
+  }
+
+  // after making a condition true
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+      // taking the lock makes sure a waiter which has checked the condition
+      // is asleep before it is woken
+      std::lock_guard<std::mutex> lock(mutex_);
+      cond_.notify_all();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::atomic<int> sleepers_;
+};
+
+// Budget bounds the work of one page by wall time and by the number of keys
+// examined, matched or not, so a rarely matching predicate cannot walk the
+// whole shard in one call; a cancelled scan ends the same way. Once
+// exhausted, `lastkey` is the last key examined and the page resumes right
+// after it.
+class Budget {
+ public:
+  Budget() : Budget(0, 0, nullptr) {}
+  Budget(uint64_t timeout_ms, size_t max_keys, const Cancel *cancel)
+      : timeout_(timeout_ms > 0),
+        deadline_(std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms)),
+        max_keys_(max_keys),
+        cancel_(cancel),
+        examined_(0),
+        exhausted_(false) {}
+  ~Budget() = default;
+
+  // called once per examined key, false once the budget is exhausted
+  bool spend(const rocksdb::Slice &key) {
+    examined_++;
+    if ((max_keys_ > 0 && examined_ >= max_keys_) ||
+        (examined_ % budget_check_stride == 0 && checked_out())) {
+      exhausted_ = true;
+      lastkey_.assign(key.data(), key.size());
+      return false;
+    }
+    return true;
+  }
+
+  // ends the page at `key`, the last key the walk got to, see Walk::limit
+  void exhaust(const std::string &key) {
+    exhausted_ = true;
+    lastkey_ = key;
+  }
+
+  bool exhausted() const { return exhausted_; }
+  const std::string &lastkey() const { return lastkey_; }
+  size_t examined() const { return examined_; }
+  size_t max_keys() const { return max_keys_; }
+
+  // the deadline passed or the scan was cancelled; unlike spend, it may be
+  // called from another thread
+  bool checked_out() const {
+    return (cancel_ != nullptr && cancel_->cancelled()) ||
+           (timeout_ && std::chrono::steady_clock::now() >= deadline_);
+  }
+
+ private:
+  bool timeout_;
+  std::chrono::steady_clock::time_point deadline_;
+  size_t max_keys_;
+  const Cancel *cancel_;
+  size_t examined_;
+  bool exhausted_;
+  std::string lastkey_;
+};
+
+// Walk drives the iterator of a scan in scan order over the ranges of its
+// plan: it hops from the end of a range to the start of the next one, so the
+// keys in between are never read. A skip-scan hops the same way between the
+// windows of the leading values. Otherwise it walks the iterator whole.
+class Walk {
+ public:
+  Walk() = delete;
+  Walk(rocksdb::Iterator *it, const Plan &plan, bool reverse)
+      : it_(it),
+        plan_(plan),
+        reverse_(reverse),
+        range_(0),
+        budget_(nullptr),
+        seeks_(0),
+        stopped_(false) {}
+  ~Walk() = default;
+
+  rocksdb::Iterator *iterator() const { return it_; }
+
+  // bounds the seeks of a skip-scan by `budget` until reset with nullptr:
+  // each seek counts like an examined key and checks the deadline and the
+  // cancel token, so a walk across empty windows stops on time. The walk
+  // then ends with `stopped`, on the key it would have sought from.
+  void limit(const Budget *budget) {
+    budget_ = budget;
+    seeks_ = 0;
+    stopped_ = false;
+    stopped_at_.clear();
+  }
+  bool stopped() const { return stopped_; }
+  const std::string &stopped_at() const { return stopped_at_; }
+
+  // positions on the first entry of the plan. Forward scans resume after
+  // `after`, so an entry equal to it is skipped; reverse scans resume below
+  // the upper bound, which is exclusive anyway.
+  void seek_first(const rocksdb::Slice &after) {
+    range_ = 0;
+    rocksdb::Slice first = plan_.lower;
+    rocksdb::Slice last = plan_.upper;
+    if (reverse_) {
+      if (last.size() > 0) {
+        it_->SeekForPrev(last);
+        if (it_->Valid() && it_->key() == last) {
+          it_->Prev();
+        }
+      } else {
+        it_->SeekToLast();
+      }
+      return;
+    }
+    if (first.size() > 0) {
+      it_->Seek(first);
+      if (it_->Valid() && after.size() > 0 && it_->key() == after) {
+        it_->Next();
+      }
+    } else {
+      it_->SeekToFirst();
+    }
+  }
+
+  // positions on the entry following `key` in the direction of the scan
+  void seek_after(const rocksdb::Slice &key) {
+    range_ = 0;
+    if (reverse_) {
+      it_->SeekForPrev(key);
+      if (it_->Valid() && it_->key() == key) {
+        it_->Prev();
+      }
+    } else {
+      it_->Seek(key);
+      if (it_->Valid() && it_->key() == key) {
+        it_->Next();
+      }
+    }
+  }
+
+  void next() {
+    if (reverse_) {
+      it_->Prev();
+    } else {
+      it_->Next();
+    }
+  }
+
+  // whether the iterator is on an entry of the plan, hopping to the next
+  // range when it left one
+  bool valid() {
+    if (plan_.skip) {
+      return skip();
+    }
+    if (!plan_.ranged) {
+      return it_->Valid();
+    }
+    const std::vector<KeyRange> &ranges = plan_.ranges;
+    size_t n = ranges.size();
+    while (it_->Valid()) {
+      rocksdb::Slice key = it_->key();
+      if (!reverse_) {
+        while (range_ < n && !ranges[range_].end.empty() &&
+               key.compare(ranges[range_].end) >= 0) {
+          range_++;
+        }
+        if (range_ == n) {
+          return false;
+        }
+        if (key.compare(ranges[range_].start) < 0) {
+          it_->Seek(ranges[range_].start);
+          continue;
+        }
+        return true;
+      }
+      while (range_ < n && key.compare(ranges[n - 1 - range_].start) < 0) {
+        range_++;
+      }
+      if (range_ == n) {
+        return false;
+      }
+      const KeyRange &range = ranges[n - 1 - range_];
+      if (!range.end.empty() && key.compare(range.end) >= 0) {
+        it_->SeekForPrev(range.end);
+        if (it_->Valid() && it_->key() == range.end) {
+          it_->Prev();
+        }
+        continue;
+      }
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  // skip-scan: seeks from the entry of a leading value outside of the window
+  // to the window of this value, or past it to the next value
+  bool skip() {
+    char sep = plan_.separator;
+    while (it_->Valid()) {
+      rocksdb::Slice key = it_->key();
+      const char *pos = (const char *)memchr(key.data(), sep, key.size());
+      if (pos == nullptr) {
+        return true;
+      }
+      size_t len = pos - key.data();
+      rocksdb::Slice rest(pos + 1, key.size() - len - 1);
+      bool before = rest.compare(plan_.window_lo) < 0;
+      bool after = rest.compare(plan_.window_hi) >= 0;
+      if (!before && !after) {
+        return true;
+      }
+      if (!afford(key)) {
+        return false;
+      }
+      std::string target(key.data(), len + 1);
+      if (!reverse_) {
+        if (before) {
+          target.append(plan_.window_lo);
+        } else {
+          target.back() = (char)(sep + 1);
+        }
+        it_->Seek(target);
+        continue;
+      }
+      if (after) {
+        target.append(plan_.window_hi);
+      }
+      it_->SeekForPrev(target);
+      if (it_->Valid() && it_->key() == target) {
+        it_->Prev();
+      }
+    }
+    return false;
+  }
+
+  // false once the budget does not allow another seek from `key`
+  bool afford(const rocksdb::Slice &key) {
+    if (budget_ == nullptr) {
+      return true;
+    }
+    seeks_++;
+    if ((budget_->max_keys() > 0 && seeks_ >= budget_->max_keys()) ||
+        budget_->checked_out()) {
+      stopped_ = true;
+      stopped_at_.assign(key.data(), key.size());
+      return false;
+    }
+    return true;
+  }
+
+  rocksdb::Iterator *it_;
+  const Plan &plan_;
+  bool reverse_;
+  // ranges passed so far, in scan order
+  size_t range_;
+  const Budget *budget_;
+  size_t seeks_;
+  bool stopped_;
+  std::string stopped_at_;
+};
+
+// loads the value of an entry read with allow_unprepared_value, false on
+// error, which also invalidates the iterator
+static bool prepare_value(rocksdb::Iterator *it) {
+#if DISGORGE_LAZY_VALUE
+  return it->PrepareValue();
+#else
+  (void)it;
+  return true;
+#endif
+}
+
+// Matcher evaluates the predicate of a scan on one entry. Key predicates are
+// decided on the decoded key first: entries they reject are never parsed nor
+// even loaded, and the value is only parsed when they leave the outcome open.
+// One matcher per thread, it keeps the decoded key between the two steps.
+class Matcher {
+ public:
+  Matcher() = delete;
+  Matcher(const std::shared_ptr<query::Boolean> &expr,
+          const query::KeySchema &schema)
+      : expr_(expr), schema_(schema), on_key_(expr->uses_key()) {}
+  ~Matcher() = default;
+
+  // kTrue and kFalse are decided by the key, kUnknown needs the value
+  query::Tri on_key(const rocksdb::Slice &key) {
+    if (!on_key_) {
+      return query::kUnknown;
+    }
+    schema_.decode({key.data(), key.size()}, key_doc_);
+    return expr_->ExecKey(key_doc_);
+  }
+
+  // after on_key left the entry undecided; a value which is not valid json
+  // does not match
+  bool on_value(const rocksdb::Slice &value) {
+    try {
+      const json &doc = json::parse(value.data(), value.data() + value.size());
+      return expr_->ExecEntry(key_doc_, doc);
+    } catch (...) {
+      return false;
+    }
+  }
+
+  bool match(const rocksdb::Slice &key, const rocksdb::Slice &value) {
+    query::Tri tri = on_key(key);
+    if (tri != query::kUnknown) {
+      return tri == query::kTrue;
+    }
+    return on_value(value);
+  }
+
+ private:
+  std::shared_ptr<query::Boolean> expr_;
+  const query::KeySchema &schema_;
+  bool on_key_;
+  json key_doc_;
+};
+
+// called in scan order for every matched document, return false to stop;
+// the key and the value are only valid during the call
+using Collector = std::function<bool(const rocksdb::Slice &key,
+                                     const rocksdb::Slice &value)>;
+
+// Pipeline overlaps iterator I/O with json parsing and predicate evaluation:
+// one producer thread drives the iterator and publishes the key/value of each
+// entry into a slot of a fixed window, `workers` threads pop the slot sequence
+// numbers from the ring and evaluate the predicate, and the calling thread
+// walks the window in sequence order so matches are collected in scan order.
+//
+// The key and the value of an entry are copied into its slot, since the
+// iterator has moved on by the time they are evaluated. Entries which the key
+// predicates decide are settled by the producer and never reach the workers.
+class Pipeline {
+ public:
+  Pipeline() = delete;
+  explicit Pipeline(size_t workers)
+      : workers_(workers),
+        slots_(new Slot[pipeline_window]),
+        ring_(pipeline_window),
+        stop_(false),
+        done_(false),
+        produced_(0) {}
+  ~Pipeline() = default;
+
+  // the status of the iterator once the producer stopped
+  rocksdb::Status run(Walk &walk, const std::shared_ptr<query::Boolean> &expr,
+                      const query::KeySchema &schema, const Collector &collect,
+                      Budget &budget) {
+    std::thread producer([&] { produce(walk, Matcher(expr, schema)); });
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < workers_; i++) {
+      workers.emplace_back([&] { work(Matcher(expr, schema)); });
+    }
+
+    bool drained = false;
+    for (size_t next = 0;; next++) {
+      Slot &slot = slots_[next & (pipeline_window - 1)];
+      int state = wait_evaluated(slot, next);
+      if (state == kEmpty) {
+        drained = true;
+        break;
+      }
+      bool more =
+          (state != kMatched || collect(slot.key, slot.value)) &&
+          budget.spend(slot.key);
+      slot.state.store(kEmpty, std::memory_order_release);
+      freed_.notify();
+      if (!more) {
+        break;
+      }
+    }
+
+    stop_.store(true, std::memory_order_release);
+    freed_.notify();
+    queued_.notify();
+    producer.join();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    // everything read was collected, the walk ended on the budget
+    if (drained && walk.stopped()) {
+      budget.exhaust(walk.stopped_at());
+    }
+    return status_;
+  }
+
+ private:
+  enum State : int { kEmpty, kQueued, kMatched, kSkipped };
+
+  struct Slot {
+    std::atomic<int> state{kEmpty};
+    rocksdb::Slice key;
+    rocksdb::Slice value;
+    std::string key_buf;
+    std::string value_buf;
+  };
+
+  void produce(Walk &walk, Matcher matcher) {
+    rocksdb::Iterator *it = walk.iterator();
+    size_t seq = 0;
+    for (; walk.valid(); walk.next()) {
+      Slot &slot = slots_[seq & (pipeline_window - 1)];
+      freed_.wait([&] {
+        return stop_.load(std::memory_order_acquire) ||
+               slot.state.load(std::memory_order_acquire) == kEmpty;
+      });
+      // the consumer may have stopped with free slots left, do not read
+      // ahead for nobody
+      if (stop_.load(std::memory_order_acquire)) {
+        break;
+      }
+      slot.key_buf.assign(it->key().data(), it->key().size());
+      slot.key = slot.key_buf;
+      query::Tri tri = matcher.on_key(slot.key);
+      if (tri != query::kFalse) {
+        if (!prepare_value(it)) {
+          goto finish;
+        }
+        rocksdb::Slice value = it->value();
+        slot.value_buf.assign(value.data(), value.size());
+        slot.value = slot.value_buf;
+      }
+      if (tri != query::kUnknown) {
+        slot.state.store(tri == query::kTrue ? kMatched : kSkipped,
+                         std::memory_order_release);
+        evaluated_.notify();
+      } else {
+        slot.state.store(kQueued, std::memory_order_release);
+        // a queued sequence number holds a busy slot, so the ring, as large
+        // as the window, always has room
+        ring_.push(seq);
+        queued_.notify();
+      }
+      seq++;
+    }
+  finish:
+    status_ = it->status();
+    produced_.store(seq, std::memory_order_relaxed);
+    done_.store(true, std::memory_order_release);
+    evaluated_.notify();
+    queued_.notify();
+  }
+
+  void work(Matcher matcher) {
+    size_t seq;
+    for (;;) {
+      bool popped = false;
+      queued_.wait([&] {
+        popped = ring_.pop(seq);
+        return popped || stop_.load(std::memory_order_acquire) ||
+               done_.load(std::memory_order_acquire);
+      });
+      if (!popped && !ring_.pop(seq)) {
+        return;
+      }
+      Slot &slot = slots_[seq & (pipeline_window - 1)];
+      bool matched = matcher.match(slot.key, slot.value);
+      slot.state.store(matched ? kMatched : kSkipped,
+                       std::memory_order_release);
+      evaluated_.notify();
+    }
+  }
+
+  // wait for the slot holding `seq` to be evaluated,
+  // kEmpty means the producer is exhausted before `seq`
+  int wait_evaluated(Slot &slot, size_t seq) {
+    int state = kEmpty;
+    evaluated_.wait([&] {
+      state = slot.state.load(std::memory_order_acquire);
+      if (state == kMatched || state == kSkipped) {
+        return true;
+      }
+      return state == kEmpty && done_.load(std::memory_order_acquire) &&
+             seq >= produced_.load(std::memory_order_relaxed);
+    });
+    return state == kMatched || state == kSkipped ? state : kEmpty;
+  }
+
+ private:
+  size_t workers_;
+  std::unique_ptr<Slot[]> slots_;
+  Ring<size_t> ring_;
+  std::atomic<bool> stop_;
+  std::atomic<bool> done_;
+  std::atomic<size_t> produced_;
+  rocksdb::Status status_;
+  // the calling thread waits for evaluated slots, the producer for free ones
+  // and the workers for queued ones
+  Parker evaluated_;
+  Parker freed_;
+  Parker queued_;
+};
+
+// evaluates the predicate from the current position of the iterator on,
+// on the calling thread or through a pipeline of `parallelism` workers,
+// until the collector or the budget says stop. A read error ends the walk
+// like the end of the data does, the status of the iterator tells them
+// apart.
+static rocksdb::Status drain(Walk &walk,
+                             const std::shared_ptr<query::Boolean> &expr,
+                             const ScanOptions &scan_options,
+                             const Collector &collect, Budget &budget) {
+  const query::KeySchema &schema = key_schema(scan_options);
+  walk.limit(&budget);
+  if (scan_options.parallelism > 1) {
+    Pipeline pipeline(scan_options.parallelism);
+    rocksdb::Status status = pipeline.run(walk, expr, schema, collect, budget);
+    walk.limit(nullptr);
+    return status;
+  }
+  Matcher matcher(expr, schema);
+  rocksdb::Iterator *it = walk.iterator();
+  for (; walk.valid(); walk.next()) {
+    query::Tri tri = matcher.on_key(it->key());
+    if (tri != query::kFalse) {
+      if (!prepare_value(it)) {
+        break;
+      }
+      const rocksdb::Slice &value = it->value();
+      if ((tri == query::kTrue || matcher.on_value(value)) &&
+          !collect(it->key(), value)) {
+        break;
+      }
+    }
+    if (!budget.spend(it->key())) {
+      break;
+    }
+  }
+  if (walk.stopped()) {
+    budget.exhaust(walk.stopped_at());
+  }
+  walk.limit(nullptr);
+  return it->status();
+}
+}  // namespace disgorge
+
+#endif  // DISGORGE_PIPELINE_HPP
@@ -0,0 +1,522 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_PLANNER_HPP
+#define DISGORGE_PLANNER_HPP
+
+#pragma once
+
+#include <rocksdb/db.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "query.hpp"
+
+namespace disgorge {
+
+// [start, end) of keys, an empty end is unbounded
+struct KeyRange {
+  std::string start;
+  std::string end;
+};
+
+// Plan is what the planner derives from the key ranges of a request and the
+// key predicates of its query: the key ranges which can hold matches, in key
+// order, and their hull, which tightens the bounds of the iterator. Without
+// ranges the scan walks [lower, upper) whole.
+struct Plan {
+  // the ranges of the request, sorted and coalesced; a resume point names
+  // one of them
+  std::vector<KeyRange> requested;
+  bool ranged = false;
+  // empty while ranged: nothing can match
+  std::vector<KeyRange> ranges;
+  std::string lower;
+  std::string upper;
+  // skip-scan, for an open leading component and a bounded second one: the
+  // walk only reads `lead|window_lo` up to `lead|window_hi` of every leading
+  // value and seeks over the rest
+  bool skip = false;
+  char separator = '|';
+  std::string window_lo;
+  std::string window_hi;
+};
+
+// a seek costs about as many key comparisons and block reads as this many
+// nexts
+const size_t seek_cost = 32;
+// keys read to estimate the cost of a skip-scan
+const size_t skip_sample_keys = 1024;
+
+// Domain is the set of values the predicate leaves to a key component: any
+// value, none, a set of values or a closed interval
+template <typename T>
+struct Domain {
+  enum Kind : int { kAll, kNone, kPoints, kInterval };
+  Kind kind = kAll;
+  std::set<T> points;
+  T lo{};
+  T hi{};
+
+  static Domain all() { return Domain(); }
+  static Domain none() {
+    Domain d;
+    d.kind = kNone;
+    return d;
+  }
+  static Domain of(const std::vector<T> &values) {
+    Domain d;
+    d.kind = values.empty() ? kNone : kPoints;
+    d.points.insert(values.begin(), values.end());
+    return d;
+  }
+  static Domain between(const T &lo, const T &hi) {
+    if (hi < lo) {
+      return none();
+    }
+    Domain d;
+    d.kind = kInterval;
+    d.lo = lo;
+    d.hi = hi;
+    return d;
+  }
+
+  // the values of both
+  static Domain intersect(const Domain &a, const Domain &b) {
+    if (a.kind == kAll || b.kind == kNone) {
+      return b;
+    }
+    if (b.kind == kAll || a.kind == kNone) {
+      return a;
+    }
+    if (a.kind == kInterval && b.kind == kInterval) {
+      return between(std::max(a.lo, b.lo), std::min(a.hi, b.hi));
+    }
+    const Domain &p = a.kind == kPoints ? a : b;
+    const Domain &q = a.kind == kPoints ? b : a;
+    std::vector<T> values;
+    for (auto &v : p.points) {
+      if (q.kind == kPoints ? q.points.count(v) > 0
+                            : !(v < q.lo) && !(q.hi < v)) {
+        values.push_back(v);
+      }
+    }
+    return of(values);
+  }
+
+  // the values of either, widened to the hull when they do not combine
+  static Domain unite(const Domain &a, const Domain &b) {
+    if (a.kind == kAll || b.kind == kNone) {
+      return a;
+    }
+    if (b.kind == kAll || a.kind == kNone) {
+      return b;
+    }
+    if (a.kind == kPoints && b.kind == kPoints) {
+      Domain d = a;
+      d.points.insert(b.points.begin(), b.points.end());
+      return d;
+    }
+    return between(std::min(a.min(), b.min()), std::max(a.max(), b.max()));
+  }
+
+  const T &min() const { return kind == kPoints ? *points.begin() : lo; }
+  const T &max() const { return kind == kPoints ? *points.rbegin() : hi; }
+};
+
+// the domain which `expr` leaves to the key component `column`; only key
+// predicates narrow it, the others may hold for any key
+template <typename T>
+static Domain<T> domain(query::Boolean *expr, const std::string &column) {
+  using D = Domain<T>;
+  if (expr == nullptr) {
+    return D::all();
+  }
+  if (expr->type() == query::kAndType) {
+    auto *node = (query::AndBoolean *)expr;
+    return D::intersect(domain<T>(node->left(), column),
+                        domain<T>(node->right(), column));
+  }
+  if (expr->type() == query::kOrType) {
+    auto *node = (query::OrBoolean *)expr;
+    return D::unite(domain<T>(node->left(), column),
+                    domain<T>(node->right(), column));
+  }
+  if (!expr->on_key()) {
+    return D::all();
+  }
+
+  query::Type between, right_compare, left_compare, in_array;
+  if constexpr (std::is_same_v<T, int64_t>) {
+    between = query::kBetweenIntType;
+    right_compare = query::kRightCompareIntType;
+    left_compare = query::kLeftCompareIntType;
+    in_array = query::kInArrayIntType;
+  } else {
+    between = query::kBetweenStrType;
+    right_compare = query::kRightCompareStrType;
+    left_compare = query::kLeftCompareStrType;
+    in_array = query::kInArrayStrType;
+  }
+
+  query::Type type = expr->type();
+  if (type == between) {
+    auto *node = (query::Between<T> *)expr;
+    if (node->column() == column) {
+      return D::between(node->lower(), node->upper());
+    }
+  } else if (type == in_array) {
+    auto *node = (query::InArray<T> *)expr;
+    if (node->column() == column) {
+      return D::of(node->array());
+    }
+  } else if (type == query::kInSetType) {
+    // each id of the set is a seek target
+    auto *node = (query::InSet *)expr;
+    const query::IdSet &set = node->set();
+    if (node->column() == column &&
+        set.integer() == std::is_same_v<T, int64_t>) {
+      std::vector<T> values(set.size());
+      for (size_t i = 0; i < set.size(); i++) {
+        if constexpr (std::is_same_v<T, int64_t>) {
+          values[i] = set.integer(i);
+        } else {
+          values[i] = std::string(set.str(i));
+        }
+      }
+      return D::of(values);
+    }
+  } else if (type == right_compare || type == left_compare) {
+    // `left op value` reads as `value op' left` with op' mirrored
+    query::Cmp op;
+    T v;
+    if (type == right_compare) {
+      auto *node = (query::RightCompare<T> *)expr;
+      if (node->column() != column) {
+        return D::all();
+      }
+      v = node->left();
+      switch (node->op()) {
+        case query::kGreaterThan:
+          op = query::kLessThan;
+          break;
+        case query::kGreaterThanEqual:
+          op = query::kLessThanEqual;
+          break;
+        case query::kLessThan:
+          op = query::kGreaterThan;
+          break;
+        case query::kLessThanEqual:
+          op = query::kGreaterThanEqual;
+          break;
+        default:
+          op = node->op();
+          break;
+      }
+    } else {
+      auto *node = (query::LeftCompare<T> *)expr;
+      if (node->column() != column) {
+        return D::all();
+      }
+      v = node->right();
+      op = node->op();
+    }
+    if (op == query::kEqual) {
+      return D::of({v});
+    }
+    // strings only narrow on equality, their intervals are open-ended
+    if constexpr (std::is_same_v<T, int64_t>) {
+      const T min = std::numeric_limits<T>::min();
+      const T max = std::numeric_limits<T>::max();
+      switch (op) {
+        case query::kGreaterThan:
+          return v == max ? D::none() : D::between(v + 1, max);
+        case query::kGreaterThanEqual:
+          return D::between(v, max);
+        case query::kLessThan:
+          return v == min ? D::none() : D::between(min, v - 1);
+        case query::kLessThanEqual:
+          return D::between(min, v);
+        default:
+          break;
+      }
+    }
+  }
+  return D::all();
+}
+
+static size_t digits(int64_t v) {
+  return v < 0 ? 0 : std::to_string(v).size();
+}
+
+// the decimal bounds [lo, hi) of the integer component for the values of
+// `d`, false when they are not bounded or do not have as many digits
+static bool decimal_bounds(const Domain<int64_t> &d, std::string &lo,
+                           std::string &hi) {
+  if (d.kind == Domain<int64_t>::kAll || d.kind == Domain<int64_t>::kNone) {
+    return false;
+  }
+  if (d.min() < 0 || d.max() == std::numeric_limits<int64_t>::max() ||
+      digits(d.min()) != digits(d.max() + 1)) {
+    return false;
+  }
+  lo = std::to_string(d.min());
+  hi = std::to_string(d.max() + 1);
+  return true;
+}
+
+// whether a range holds no key
+static bool empty(const KeyRange &r) {
+  return !r.end.empty() && r.start >= r.end;
+}
+
+// orders `a` and `b` by their ends, an empty end being the largest
+static bool ends_before(const KeyRange &a, const KeyRange &b) {
+  return !a.end.empty() && (b.end.empty() || a.end < b.end);
+}
+
+// sorts the ranges by start, merging the ones which overlap or touch and
+// dropping the empty ones
+static std::vector<KeyRange> coalesce(std::vector<KeyRange> ranges) {
+  std::sort(ranges.begin(), ranges.end(),
+            [](const KeyRange &a, const KeyRange &b) {
+              return a.start < b.start;
+            });
+  std::vector<KeyRange> ret;
+  for (auto &r : ranges) {
+    if (empty(r)) {
+      continue;
+    }
+    if (!ret.empty()) {
+      KeyRange &last = ret.back();
+      if (last.end.empty()) {
+        continue;
+      }
+      if (r.start <= last.end) {
+        if (ends_before(last, r)) {
+          last.end = r.end;
+        }
+        continue;
+      }
+    }
+    ret.push_back(r);
+  }
+  return ret;
+}
+
+// the keys both in `a` and in `b`, which are coalesced
+static std::vector<KeyRange> intersect(const std::vector<KeyRange> &a,
+                                       const std::vector<KeyRange> &b) {
+  std::vector<KeyRange> ret;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a.size() && j < b.size()) {
+    KeyRange r;
+    r.start = std::max(a[i].start, b[j].start);
+    r.end = ends_before(a[i], b[j]) ? a[i].end : b[j].end;
+    if (!empty(r)) {
+      ret.push_back(r);
+    }
+    if (ends_before(a[i], b[j])) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+  return ret;
+}
+
+// what is left of the coalesced `ranges` after a page which stopped at
+// `lastkey` in ranges[range]: the ranges after it and the rest of it, before
+// it for reverse scans
+static std::vector<KeyRange> resume(const std::vector<KeyRange> &ranges,
+                                    size_t range,
+                                    const rocksdb::Slice &lastkey,
+                                    bool reverse) {
+  if (lastkey.size() == 0) {
+    return ranges;
+  }
+  if (range >= ranges.size()) {
+    return {};
+  }
+  std::string key = lastkey.ToString();
+  std::vector<KeyRange> ret;
+  if (reverse) {
+    ret.assign(ranges.begin(), ranges.begin() + range + 1);
+    if (ret.back().end.empty() || key < ret.back().end) {
+      ret.back().end = key;
+    }
+  } else {
+    ret.assign(ranges.begin() + range, ranges.end());
+    if (ret.front().start < key) {
+      ret.front().start = key;
+    }
+  }
+  return coalesce(ret);
+}
+
+// the index of the requested range holding `key`
+static size_t range_of(const Plan &plan, const std::string &key) {
+  const std::vector<KeyRange> &ranges = plan.requested;
+  auto iter = std::upper_bound(ranges.begin(), ranges.end(), key,
+                               [](const std::string &k, const KeyRange &r) {
+                                 return k < r.start;
+                               });
+  return iter == ranges.begin() ? 0 : iter - ranges.begin() - 1;
+}
+
+// the smallest key above all the keys starting with `prefix`, "" (no end)
+// when there is none
+static std::string prefix_successor(std::string prefix) {
+  while (!prefix.empty() && (unsigned char)prefix.back() == 0xff) {
+    prefix.pop_back();
+  }
+  if (!prefix.empty()) {
+    prefix.back()++;
+  }
+  return prefix;
+}
+
+// the end of the keys whose leading component is in [lo, hi]. A component
+// which is a proper prefix of hi sorts its keys after hi itself, "a|1" after
+// "ab}" since the separator is above 'b', so the end is the successor of
+// the shortest prefix of hi which is in the interval: all the components in
+// it either start with that prefix or sort below it.
+static std::string interval_end(const std::string &lo, const std::string &hi) {
+  for (size_t n = 0; n <= hi.size(); n++) {
+    if (hi.compare(0, n, lo) >= 0) {
+      return prefix_successor(hi.substr(0, n));
+    }
+  }
+  return prefix_successor(hi);
+}
+
+// Derives the key ranges from the key predicates on the leading components
+// of the key: a string component pinned to values (equality, InArray) or
+// bounded (Between), and then an integer component bounded for each pinned
+// value, e.g. userId and timestamp of `userId|timestamp:int`. The integer is
+// only used as a bound when both ends have as many digits, since the key
+// holds it in decimal and sorts it as a string. The ranges are intersected
+// with the coalesced ranges `within` of the request. With the leading
+// component open, a bounded integer makes a plan of one range a skip-scan
+// candidate, see estimate_skip.
+static Plan plan(query::Boolean *expr, const query::KeySchema &schema,
+                 const std::vector<KeyRange> &within) {
+  Plan ret;
+  ret.requested = within;
+  ret.separator = schema.separator();
+  if (within.size() == 1) {
+    ret.lower = within[0].start;
+    ret.upper = within[0].end;
+  } else {
+    ret.ranged = true;
+    ret.ranges = within;
+  }
+
+  std::vector<KeyRange> ranges;
+  if (expr != nullptr && expr->uses_key() && schema.size() > 0 &&
+      !schema.integer(0)) {
+    std::string sep(1, schema.separator());
+    // the end of all keys whose leading component is `v`
+    std::string after(1, (char)(schema.separator() + 1));
+    auto second = Domain<int64_t>::all();
+    if (schema.size() > 1 && schema.integer(1)) {
+      second = domain<int64_t>(expr, schema.name(1));
+    }
+
+    auto lead = domain<std::string>(expr, schema.name(0));
+    if (lead.kind == Domain<std::string>::kAll) {
+      if (second.kind == Domain<int64_t>::kNone) {
+        ret.ranged = true;
+        ret.ranges.clear();
+      } else if (!ret.ranged) {
+        ret.skip = decimal_bounds(second, ret.window_lo, ret.window_hi);
+      }
+    } else if (lead.kind == Domain<std::string>::kInterval) {
+      ret.ranged = true;
+      ret.ranges =
+          intersect(coalesce({{lead.lo, interval_end(lead.lo, lead.hi)}}),
+                    within);
+    } else {
+      std::string lo, hi;
+      bool bounded = decimal_bounds(second, lo, hi);
+      for (auto &v : lead.points) {
+        if (second.kind == Domain<int64_t>::kNone) {
+          break;
+        }
+        if (bounded) {
+          ranges.push_back({v + sep + lo, v + sep + hi});
+        } else {
+          ranges.push_back({v + sep, v + after});
+        }
+      }
+      ret.ranged = true;
+      ret.ranges = intersect(coalesce(ranges), within);
+    }
+  }
+  if (ret.ranged && !ret.ranges.empty()) {
+    ret.lower = ret.ranges.front().start;
+    ret.upper = ret.ranges.back().end;
+  }
+  return ret;
+}
+
+// the plan of a scan of [start, end)
+static Plan plan(query::Boolean *expr, const query::KeySchema &schema,
+                 const rocksdb::Slice &start, const rocksdb::Slice &end) {
+  return plan(expr, schema, coalesce({{start.ToString(), end.ToString()}}));
+}
+
+// Keeps the skip-scan of `plan` only when it is cheaper than reading the
+// keys outside of the window: the first keys of the scan give the share of
+// keys outside of it and the number of distinct leading values, each of
+// which costs about two seeks. `it` is left anywhere.
+static void estimate_skip(rocksdb::Iterator *it, Plan &plan) {
+  if (!plan.skip) {
+    return;
+  }
+  size_t users = 0;
+  size_t outside = 0;
+  std::string user;
+  it->SeekToFirst();
+  for (size_t n = 0; it->Valid() && n < skip_sample_keys; it->Next(), n++) {
+    rocksdb::Slice key = it->key();
+    const char *pos = (const char *)memchr(key.data(), plan.separator,
+                                           key.size());
+    if (pos == nullptr) {
+      continue;
+    }
+    size_t len = pos - key.data();
+    if (users == 0 || user.compare(0, user.size(), key.data(), len) != 0) {
+      user.assign(key.data(), len);
+      users++;
+    }
+    rocksdb::Slice rest(pos + 1, key.size() - len - 1);
+    if (rest.compare(plan.window_lo) < 0 ||
+        rest.compare(plan.window_hi) >= 0) {
+      outside++;
+    }
+  }
+  plan.skip = outside > users * 2 * seek_cost;
+}
+}  // namespace disgorge
+
+#endif  // DISGORGE_PLANNER_HPP
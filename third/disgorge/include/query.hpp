@@ -16,10 +16,14 @@
 #ifndef DISGORGE_QUERY_HPP
 #define DISGORGE_QUERY_HPP
 
+#include <charconv>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
+#include "idset.hpp"
 #include "json.hpp"
 using json = nlohmann::json;
 
@@ -42,7 +46,8 @@ enum Type : int {
   kInArrayFloatType,
   kInArrayStrType,
   kAndType,
-  kOrType
+  kOrType,
+  kInSetType
 };
 
 enum Cmp : int {
@@ -55,6 +60,9 @@ enum Cmp : int {
   kLessThanEqual
 };
 
+// outcome of a predicate evaluated on part of an entry
+enum Tri : int { kFalse, kTrue, kUnknown };
+
 using Field = std::variant<int, std::string>;
 
 static void check_empty(const std::string &s) {
@@ -166,15 +174,15 @@ bool cmp(const std::string &a, const std::string &b, Cmp op) {
 static Cmp str2cmp(const std::string &s) {
   if (strcmp(s.c_str(), "=") == 0 || strcmp(s.c_str(), "==") == 0) {
     return kEqual;
-  } else if (strcmp(s.c_str(), "!=") || strcmp(s.c_str(), "<>")) {
+  } else if (strcmp(s.c_str(), "!=") == 0 || strcmp(s.c_str(), "<>") == 0) {
     return kNotEqual;
-  } else if (strcmp(s.c_str(), ">")) {
+  } else if (strcmp(s.c_str(), ">") == 0) {
     return kGreaterThan;
-  } else if (strcmp(s.c_str(), ">=")) {
+  } else if (strcmp(s.c_str(), ">=") == 0) {
     return kGreaterThanEqual;
-  } else if (strcmp(s.c_str(), "<=")) {
+  } else if (strcmp(s.c_str(), "<=") == 0) {
     return kLessThanEqual;
-  } else if (strcmp(s.c_str(), "<")) {
+  } else if (strcmp(s.c_str(), "<") == 0) {
     return kLessThan;
   }
   return kError;
@@ -205,12 +213,108 @@ const json *get(const json &d,
   return tmp;
 }
 
+// KeySchema decodes a key into a document, so that predicates marked with
+// `"key": true` run on the key components instead of the value. The
+// description lists the components in key order, split on the separator,
+// and a `:int` suffix decodes the component as an integer, e.g. the upstream
+// layout `userId|timestamp:int`.
+class KeySchema {
+ public:
+  KeySchema() = delete;
+  explicit KeySchema(const std::string &description, char separator = '|')
+      : separator_(separator) {
+    size_t pos = 0;
+    for (;;) {
+      size_t end = description.find(separator_, pos);
+      std::string name = description.substr(
+          pos, end == std::string::npos ? std::string::npos : end - pos);
+      bool integer = false;
+      size_t colon = name.rfind(':');
+      if (colon != std::string::npos && name.substr(colon) == ":int") {
+        integer = true;
+        name = name.substr(0, colon);
+      }
+      check_empty(name);
+      columns_.push_back({name, integer});
+      if (end == std::string::npos) {
+        break;
+      }
+      pos = end + 1;
+    }
+  }
+  ~KeySchema() = default;
+
+  size_t size() const { return columns_.size(); }
+  const std::string &name(size_t i) const { return columns_[i].name; }
+  bool integer(size_t i) const { return columns_[i].integer; }
+  char separator() const { return separator_; }
+
+  // components which are missing or do not decode are left out
+  void decode(std::string_view key, json &doc) const {
+    doc = json::object();
+    size_t pos = 0;
+    for (auto &column : columns_) {
+      size_t end = key.find(separator_, pos);
+      if (end == std::string_view::npos) {
+        end = key.size();
+      }
+      std::string_view field = key.substr(pos, end - pos);
+      if (column.integer) {
+        int64_t v;
+        const char *last = field.data() + field.size();
+        auto ret = std::from_chars(field.data(), last, v);
+        if (ret.ec == std::errc() && ret.ptr == last) {
+          doc[column.name] = v;
+        }
+      } else {
+        doc[column.name] = std::string(field);
+      }
+      if (end == key.size()) {
+        break;
+      }
+      pos = end + 1;
+    }
+  }
+
+ private:
+  struct Column {
+    std::string name;
+    bool integer;
+  };
+  char separator_;
+  std::vector<Column> columns_;
+};
+
+const char *const default_key_schema = "userId|timestamp:int";
+
 class Boolean {
  public:
-  Boolean() = default;
+  Boolean() : on_key_(false) {}
   virtual Type type() { return kNilType; }
   virtual ~Boolean() = default;
   virtual bool Exec(const json &d) = 0;
+
+  // a predicate on the decoded key rather than on the value
+  void set_on_key(bool on_key) { on_key_ = on_key; }
+  bool on_key() const { return on_key_; }
+  virtual bool uses_key() { return on_key_; }
+  virtual bool uses_value() { return !on_key_; }
+
+  // what the key alone decides, kUnknown when the value is needed
+  virtual Tri ExecKey(const json &key) {
+    if (!on_key_) {
+      return kUnknown;
+    }
+    return Exec(key) ? kTrue : kFalse;
+  }
+
+  // evaluates on a whole entry, the key decoded by a KeySchema
+  virtual bool ExecEntry(const json &key, const json &value) {
+    return on_key_ ? Exec(key) : Exec(value);
+  }
+
+ protected:
+  bool on_key_;
 };
 
 template <class T>
@@ -263,6 +367,10 @@ class Between : public Boolean {
     return false;
   }
 
+  const T &lower() const { return lower_; }
+  const T &upper() const { return upper_; }
+  const std::string &column() const { return col_; }
+
  private:
   T lower_;
   T upper_;
@@ -319,6 +427,10 @@ class RightCompare : public Boolean {
     return false;
   }
 
+  const T &left() const { return left_; }
+  Cmp op() const { return op_; }
+  const std::string &column() const { return col_; }
+
  private:
   T left_;
   std::string col_;
@@ -375,6 +487,10 @@ class LeftCompare : public Boolean {
     return false;
   }
 
+  const T &right() const { return right_; }
+  Cmp op() const { return op_; }
+  const std::string &column() const { return col_; }
+
  private:
   T right_;
   std::string col_;
@@ -446,6 +562,9 @@ class InArray : public Boolean {
     return false;
   }
 
+  const std::vector<T> &array() const { return array_; }
+  const std::string &column() const { return col_; }
+
  private:
   std::vector<T> array_;
   std::string col_;
@@ -552,6 +671,43 @@ class BinaryLike : public Boolean {
   std::shared_ptr<std::vector<Field>> fields_;
 };
 
+// InSet tests membership in an uploaded IdSet, referenced by its handle;
+// integer sets match integer columns, string sets string ones
+class InSet : public Boolean {
+ public:
+  InSet() = delete;
+  InSet(std::shared_ptr<const IdSet> set, const std::string &col)
+      : set_(set), col_(col) {
+    fields_ = extract_fields(col_);
+  }
+  virtual ~InSet() = default;
+
+  virtual Type type() { return kInSetType; }
+
+  virtual bool Exec(const json &d) {
+    const json *ptr = get(d, fields_);
+    if (ptr == nullptr) {
+      return false;
+    }
+    const json &c = *ptr;
+    if (set_->integer()) {
+      return c.is_number_integer() && set_->contains(c.get<int64_t>());
+    }
+    if (!(c.type() == json::value_t::string)) {
+      return false;
+    }
+    return set_->contains(c.get_ref<const std::string &>());
+  }
+
+  const IdSet &set() const { return *set_; }
+  const std::string &column() const { return col_; }
+
+ private:
+  std::shared_ptr<const IdSet> set_;
+  std::string col_;
+  std::shared_ptr<std::vector<Field>> fields_;
+};
+
 class AndBoolean : public Boolean {
  public:
   AndBoolean() = delete;
@@ -560,6 +716,27 @@ class AndBoolean : public Boolean {
   virtual ~AndBoolean() = default;
   virtual Type type() { return kAndType; }
   virtual bool Exec(const json &d) { return left_->Exec(d) && right_->Exec(d); }
+  virtual bool uses_key() { return left_->uses_key() || right_->uses_key(); }
+  virtual bool uses_value() {
+    return left_->uses_value() || right_->uses_value();
+  }
+  virtual Tri ExecKey(const json &key) {
+    Tri left = left_->ExecKey(key);
+    if (left == kFalse) {
+      return kFalse;
+    }
+    Tri right = right_->ExecKey(key);
+    if (right == kFalse) {
+      return kFalse;
+    }
+    return left == kTrue && right == kTrue ? kTrue : kUnknown;
+  }
+  virtual bool ExecEntry(const json &key, const json &value) {
+    return left_->ExecEntry(key, value) && right_->ExecEntry(key, value);
+  }
+
+  Boolean *left() const { return left_.get(); }
+  Boolean *right() const { return right_.get(); }
 
  private:
   std::shared_ptr<Boolean> left_;
@@ -574,13 +751,36 @@ class OrBoolean : public Boolean {
   virtual ~OrBoolean() = default;
   virtual Type type() { return kOrType; }
   virtual bool Exec(const json &d) { return left_->Exec(d) || right_->Exec(d); }
+  virtual bool uses_key() { return left_->uses_key() || right_->uses_key(); }
+  virtual bool uses_value() {
+    return left_->uses_value() || right_->uses_value();
+  }
+  virtual Tri ExecKey(const json &key) {
+    Tri left = left_->ExecKey(key);
+    if (left == kTrue) {
+      return kTrue;
+    }
+    Tri right = right_->ExecKey(key);
+    if (right == kTrue) {
+      return kTrue;
+    }
+    return left == kFalse && right == kFalse ? kFalse : kUnknown;
+  }
+  virtual bool ExecEntry(const json &key, const json &value) {
+    return left_->ExecEntry(key, value) || right_->ExecEntry(key, value);
+  }
+
+  Boolean *left() const { return left_.get(); }
+  Boolean *right() const { return right_.get(); }
 
  private:
   std::shared_ptr<Boolean> left_;
   std::shared_ptr<Boolean> right_;
 };
 
-static std::shared_ptr<Boolean> parse_from_value(const json &document) {
+static std::shared_ptr<Boolean> parse_from_value(const json &document);
+
+static std::shared_ptr<Boolean> parse_node(const json &document) {
   if (!document.contains("type")) {
     return nullptr;
   }
@@ -652,16 +852,40 @@ static std::shared_ptr<Boolean> parse_from_value(const json &document) {
           document["array"].get<std::vector<std::string>>(),
           document["column"].get<std::string>());
     case kAndType:
-      return std::make_shared<AndBoolean>(parse_from_value(document["left"]),
-                                          parse_from_value(document["right"]));
-    case kOrType:
-      std::make_shared<OrBoolean>(parse_from_value(document["left"]),
-                                  parse_from_value(document["right"]));
+    case kOrType: {
+      auto left = parse_from_value(document["left"]);
+      auto right = parse_from_value(document["right"]);
+      if (left == nullptr || right == nullptr) {
+        return nullptr;
+      }
+      if (type == kAndType) {
+        return std::make_shared<AndBoolean>(left, right);
+      }
+      return std::make_shared<OrBoolean>(left, right);
+    }
+    case kInSetType: {
+      // unknown handles make the query invalid
+      auto set = IdSetRegistry::instance().get(document["set"].get<uint64_t>());
+      if (set == nullptr) {
+        return nullptr;
+      }
+      return std::make_shared<InSet>(set,
+                                     document["column"].get<std::string>());
+    }
     default:
       return nullptr;
   }
 }
 
+static std::shared_ptr<Boolean> parse_from_value(const json &document) {
+  auto ret = parse_node(document);
+  if (ret != nullptr && document.contains("key") &&
+      document["key"].get<bool>()) {
+    ret->set_on_key(true);
+  }
+  return ret;
+}
+
 static std::shared_ptr<Boolean> parse(const char *data, size_t len) {
   const json &document = json::parse(std::string_view{data, len});
   return parse_from_value(document);
@@ -0,0 +1,334 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#ifndef DISGORGE_RESPONSE_HPP
+#define DISGORGE_RESPONSE_HPP
+
+#pragma once
+
+#include <rocksdb/db.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pipeline.hpp"
+
+namespace disgorge {
+
+class Instance;
+class Cursor;
+
+// Response holds the matched values copied out of the sst blocks: pinning
+// them there instead would keep every block the scan visited, matched or
+// not, until the response is deleted. The values are appended back to back
+// to one growable buffer as they are collected, value i being
+// buffer[offsets[i], offsets[i + 1]), and `frame` writes them
+// length-prefixed straight into memory of the caller. `data`, `json` and
+// `ndjson` write the page the way the server answers it, as the api.Data
+// message, a json array or newline delimited json, so the server forwards
+// it as is.
+class Response {
+ public:
+  Response()
+      : more_(0),
+        lastkey_(""),
+        lastrange_(0),
+        offsets_(1, 0),
+        held_back_(false) {}
+  ~Response() = default;
+  int more() { return more_; }
+  // false when the scan stopped on a read error, the values before it are
+  // good but the rest of the shard cannot be read
+  bool ok() { return status_.ok(); }
+  const rocksdb::Status &status() { return status_; }
+  size_t size() const { return offsets_.size() - 1; }
+  size_t bytes() const { return buffer_.size(); }
+  const std::string &lastkey() { return lastkey_; }
+  // the requested range holding lastkey
+  size_t lastrange() { return lastrange_; }
+  rocksdb::Slice operator[](size_t i) const {
+    return {buffer_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]};
+  }
+  const char *buffer() const { return buffer_.data(); }
+  const uint64_t *offsets() const { return offsets_.data(); }
+  // false when key i of a multiget was not found; its value is empty then,
+  // like a found value which is empty
+  bool found(size_t i) const { return i >= found_.size() || found_[i]; }
+
+  // the size of the framed page: each value preceded by its length as 4
+  // bytes little endian
+  size_t framed_size() const { return 4 * size() + bytes(); }
+
+  // frames the page into `dst`, memory of the caller, in one copy per value;
+  // 0 when it does not fit in `cap`
+  size_t frame(char *dst, size_t cap) const {
+    if (cap < framed_size()) {
+      return 0;
+    }
+    char *p = dst;
+    for (size_t i = 0; i < size(); i++) {
+      rocksdb::Slice value = (*this)[i];
+      uint32_t len = value.size();
+      for (int b = 0; b < 4; b++) {
+        *p++ = (char)(len >> (8 * b));
+      }
+      memcpy(p, value.data(), value.size());
+      p += value.size();
+    }
+    return p - dst;
+  }
+
+  // the size of the page as the api.Data message: `repeated string items = 1`
+  // in protobuf wire format
+  size_t data_size() const {
+    size_t n = bytes();
+    for (size_t i = 0; i < size(); i++) {
+      n += 1 + varint_size(offsets_[i + 1] - offsets_[i]);
+    }
+    return n;
+  }
+
+  // writes the page into `dst` as the api.Data message, which the server
+  // forwards without decoding it; 0 when it does not fit in `cap`
+  size_t data(char *dst, size_t cap) const {
+    if (cap < data_size()) {
+      return 0;
+    }
+    char *p = dst;
+    for (size_t i = 0; i < size(); i++) {
+      rocksdb::Slice value = (*this)[i];
+      *p++ = 0x0a;  // field 1, length delimited
+      for (uint64_t len = value.size();; len >>= 7) {
+        if (len < 0x80) {
+          *p++ = (char)len;
+          break;
+        }
+        *p++ = (char)(0x80 | (len & 0x7f));
+      }
+      memcpy(p, value.data(), value.size());
+      p += value.size();
+    }
+    return p - dst;
+  }
+
+  // the size of the page as a json array: the values are json documents
+  // and go in as they are when `raw`, or as escaped strings otherwise
+  size_t json_size(bool raw) const {
+    size_t n = 2 + (size() == 0 ? 0 : size() - 1);
+    if (raw) {
+      return n + bytes();
+    }
+    for (size_t i = 0; i < size(); i++) {
+      n += 2 + escaped_size((*this)[i]);
+    }
+    return n;
+  }
+
+  // writes the page into `dst` as a json array, see json_size; 0 when it
+  // does not fit in `cap`
+  size_t json(char *dst, size_t cap, bool raw) const {
+    if (cap < json_size(raw)) {
+      return 0;
+    }
+    char *p = dst;
+    *p++ = '[';
+    for (size_t i = 0; i < size(); i++) {
+      if (i > 0) {
+        *p++ = ',';
+      }
+      rocksdb::Slice value = (*this)[i];
+      if (raw) {
+        memcpy(p, value.data(), value.size());
+        p += value.size();
+      } else {
+        p = escape(value, p);
+      }
+    }
+    *p++ = ']';
+    return p - dst;
+  }
+
+  // the size of the page as newline delimited json, a value a line
+  size_t ndjson_size() const { return bytes() + size(); }
+
+  // writes the page into `dst` as newline delimited json; a line break in a
+  // json document can only be whitespace, so it becomes a space. 0 when it
+  // does not fit in `cap`
+  size_t ndjson(char *dst, size_t cap) const {
+    if (cap < ndjson_size()) {
+      return 0;
+    }
+    char *p = dst;
+    for (size_t i = 0; i < size(); i++) {
+      rocksdb::Slice value = (*this)[i];
+      memcpy(p, value.data(), value.size());
+      for (char *end = p + value.size(); p < end; p++) {
+        if (*p == '\n' || *p == '\r') {
+          *p = ' ';
+        }
+      }
+      *p++ = '\n';
+    }
+    return p - dst;
+  }
+
+ private:
+  static size_t varint_size(uint64_t v) {
+    size_t n = 1;
+    for (; v >= 0x80; v >>= 7) {
+      n++;
+    }
+    return n;
+  }
+
+  // the short escapes of json, 'u' for the ones written as \u00XX
+  static char escape_of(unsigned char c) {
+    switch (c) {
+      case '"':
+        return '"';
+      case '\\':
+        return '\\';
+      case '\b':
+        return 'b';
+      case '\f':
+        return 'f';
+      case '\n':
+        return 'n';
+      case '\r':
+        return 'r';
+      case '\t':
+        return 't';
+      default:
+        return c < 0x20 ? 'u' : 0;
+    }
+  }
+
+  static size_t escaped_size(const rocksdb::Slice &value) {
+    size_t n = value.size();
+    for (size_t i = 0; i < value.size(); i++) {
+      char e = escape_of(value[i]);
+      n += e == 0 ? 0 : (e == 'u' ? 5 : 1);
+    }
+    return n;
+  }
+
+  // writes `value` as a quoted json string, the bytes past 0x7f go through
+  // as they are
+  static char *escape(const rocksdb::Slice &value, char *p) {
+    static const char hex[] = "0123456789abcdef";
+    *p++ = '"';
+    for (size_t i = 0; i < value.size(); i++) {
+      unsigned char c = value[i];
+      char e = escape_of(c);
+      if (e == 0) {
+        *p++ = c;
+        continue;
+      }
+      *p++ = '\\';
+      *p++ = e;
+      if (e == 'u') {
+        *p++ = '0';
+        *p++ = '0';
+        *p++ = hex[c >> 4];
+        *p++ = hex[c & 0xf];
+      }
+    }
+    *p++ = '"';
+    return p;
+  }
+
+ private:
+  void append(const rocksdb::Slice &value) {
+    buffer_.append(value.data(), value.size());
+    offsets_.push_back(buffer_.size());
+  }
+
+  // appends the empty value of a key which was not found, see found
+  void miss() {
+    found_.resize(size(), true);
+    append(rocksdb::Slice());
+    found_.push_back(false);
+  }
+
+  // collects matches until the page holds `limit_rows` values or the next
+  // one would take it over `limit_bytes` (0: no byte limit), whichever comes
+  // first. The page of the request holds at least one value so that paging
+  // always makes progress: a value over the limit is only taken when it is
+  // the first of `page`, or of this response when there is no `page`.
+  // lastkey_ is the key of the last value taken: the next page resumes right
+  // after it. `held_back_` tells that the entry the scan stopped on did not
+  // fit and was left for the next page. A scan which ends before it took or
+  // examined anything has more and an empty lastkey_: the next page starts
+  // where this one did.
+  Collector filler(size_t limit_rows, size_t limit_bytes, RequestPage *page) {
+    return [this, limit_rows, limit_bytes, page](const rocksdb::Slice &key,
+                                                 const rocksdb::Slice &value) {
+      if (limit_bytes > 0 && bytes() + value.size() > limit_bytes &&
+          !(size() == 0 && (page == nullptr || page->claim()))) {
+        more_ = 1;
+        held_back_ = true;
+        return false;
+      }
+      if (page != nullptr) {
+        page->fill();
+      }
+      append(value);
+      lastkey_.assign(key.data(), key.size());
+      if (size() >= limit_rows) {
+        more_ = 1;
+        return false;
+      }
+      return true;
+    };
+  }
+
+  // after the scan: a spent budget ends the page early at the last key
+  // examined, and lastkey is only meaningful when there is more
+  void seal(const Budget &budget, const Plan &plan,
+            const rocksdb::Status &status) {
+    status_ = status;
+    if (!status_.ok()) {
+      more_ = 0;
+    } else if (budget.exhausted() && more_ == 0) {
+      more_ = 1;
+      lastkey_ = budget.lastkey();
+    }
+    if (more_ == 0) {
+      lastkey_.clear();
+    } else {
+      lastrange_ = range_of(plan, lastkey_);
+    }
+  }
+
+ private:
+  int more_;
+  rocksdb::Status status_;
+  std::string lastkey_;
+  size_t lastrange_;
+  std::string buffer_;
+  std::vector<uint64_t> offsets_;
+  bool held_back_;
+  // set by multiget only, once a key is missing
+  std::vector<bool> found_;
+  friend class Instance;
+  friend class Cursor;
+};
+}  // namespace disgorge
+
+#endif  // DISGORGE_RESPONSE_HPP
@@ -0,0 +1,66 @@
+//
+// `disgorge` - 'trace log querier for recommender system'
+// Copyright (C) 2019 - present timepi <timepi123@gmail.com>
+// LuBan is provided under: GNU Affero General Public License (AGPL3.0)
+// https://www.gnu.org/licenses/agpl-3.0.html unless stated otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be usefulType,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Affero General Public License for more details.
+//
+
+#include <chrono>
+#include <iostream>
+
+#include "instance.hpp"
+
+// usage: bench <shard dir> <userId> <start ts> <end ts> <query> [rounds]
+//
+// times the userId-scoped scan, which is the most common query shape and the
+// one served by the prefix seek path
+void bench_user_scan(disgorge::Instance &ins, const std::string &query,
+                     const std::string &start, const std::string &end,
+                     int rounds) {
+  size_t rows = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    disgorge::Response *resp = ins.scan(query, start, end);
+    if (resp == nullptr) {
+      std::cerr << "invalid query: " << query << std::endl;
+      return;
+    }
+    rows += resp->size();
+    delete resp;
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - begin)
+                  .count();
+  std::cout << "rounds: " << rounds << ", rows: " << rows
+            << ", avg: " << cost / rounds << "us" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 6) {
+    std::cerr << "usage: " << argv[0]
+              << " <dir> <userId> <start> <end> <query> [rounds]" << std::endl;
+    return 1;
+  }
+  std::string user = argv[2];
+  std::string start = user + "|" + argv[3];
+  std::string end = user + "|" + std::to_string(std::stoll(argv[4]) + 1);
+  std::string query = argv[5];
+  int rounds = argc > 6 ? std::stoi(argv[6]) : 100;
+  if (rounds <= 0) {
+    std::cerr << "rounds must be positive: " << rounds << std::endl;
+    return 1;
+  }
+
+  disgorge::Instance ins(argv[1]);
+  bench_user_scan(ins, query, start, end, rounds);
+  return 0;
+}
@@ -1,7 +1,12 @@
 #include "disgorge.h"
 
+#include "async.hpp"
 #include "instance.hpp"
 
+void disgorge_block_cache_configure(unsigned long long capacity) {
+  disgorge::BlockCache::instance().configure(capacity);
+}
+
 void *disgorge_open(void *dir, unsigned long long len, void *secondary,
                     unsigned long long slen) {
   disgorge::Instance *instance = nullptr;
@@ -26,15 +31,404 @@ void disgorge_close(void *ins) {
   delete instance;
 }
 
+void *disgorge_new_scan_options() { return new disgorge::ScanOptions(); }
+
+void disgorge_scan_options_set_profile(void *opts, int profile) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->profile = profile == disgorge::kBulk ? disgorge::kBulk
+                                          : disgorge::kInteractive;
+}
+
+void disgorge_scan_options_set_parallelism(void *opts,
+                                           unsigned long long parallelism) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->parallelism = parallelism;
+}
+
+void disgorge_scan_options_set_reverse(void *opts, int reverse) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->reverse = reverse != 0;
+}
+
+void disgorge_scan_options_set_limits(void *opts, unsigned long long rows,
+                                      unsigned long long bytes) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->limit_rows = rows;
+  o->limit_bytes = bytes;
+}
+
+void disgorge_scan_options_set_budget(void *opts, unsigned long long timeout_ms,
+                                      unsigned long long max_keys) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->timeout_ms = timeout_ms;
+  o->max_keys = max_keys;
+}
+
+void disgorge_scan_options_set_cancel(void *opts, void *cancel) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->cancel = (const disgorge::Cancel *)cancel;
+}
+
+void disgorge_scan_options_set_digest(void *opts, unsigned long long digest) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->digest = digest;
+}
+
+int disgorge_scan_options_set_key_schema(void *opts, void *schema,
+                                         unsigned long long len) {
+  if (opts == nullptr || schema == nullptr || len == 0) {
+    return 0;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  try {
+    o->key_schema = std::make_shared<query::KeySchema>(
+        std::string{(char *)schema, len});
+  } catch (...) {
+    return 0;
+  }
+  return 1;
+}
+
+void disgorge_del_scan_options(void *opts) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  delete o;
+}
+
+void disgorge_scan_options_set_request_page(void *opts, void *page) {
+  if (opts == nullptr) {
+    return;
+  }
+  disgorge::ScanOptions *o = (disgorge::ScanOptions *)opts;
+  o->request_page = (disgorge::RequestPage *)page;
+}
+
+void *disgorge_new_request_page() { return new disgorge::RequestPage(); }
+
+void disgorge_del_request_page(void *page) {
+  if (page == nullptr) {
+    return;
+  }
+  disgorge::RequestPage *p = (disgorge::RequestPage *)page;
+  delete p;
+}
+
+void *disgorge_new_cancel() { return new disgorge::Cancel(); }
+
+void disgorge_cancel(void *cancel) {
+  if (cancel == nullptr) {
+    return;
+  }
+  disgorge::Cancel *c = (disgorge::Cancel *)cancel;
+  c->cancel();
+}
+
+void disgorge_del_cancel(void *cancel) {
+  if (cancel == nullptr) {
+    return;
+  }
+  disgorge::Cancel *c = (disgorge::Cancel *)cancel;
+  delete c;
+}
+
 void *disgorge_scan(void *ins, void *query, unsigned long long qlen,
                     void *start, unsigned long long slen, void *end,
-                    unsigned long long elen) {
+                    unsigned long long elen, void *opts) {
   if (ins == nullptr) {
     return nullptr;
   }
   disgorge::Instance *instance = (disgorge::Instance *)ins;
+  if (opts == nullptr) {
+    return instance->scan({(char *)query, qlen}, {(char *)start, slen},
+                          {(char *)end, elen});
+  }
   return instance->scan({(char *)query, qlen}, {(char *)start, slen},
-                        {(char *)end, elen});
+                        {(char *)end, elen}, *(disgorge::ScanOptions *)opts);
+}
+
+// range i is [bounds[2i], bounds[2i + 1]), bound j being
+// bounds[offsets[j], offsets[j + 1]); an empty end is unbounded
+static std::vector<disgorge::KeyRange> key_ranges(
+    void *bounds, const unsigned long long *offsets, unsigned long long n) {
+  std::vector<disgorge::KeyRange> ranges(n);
+  for (unsigned long long i = 0; i < n; i++) {
+    const char *data = (char *)bounds;
+    ranges[i].start.assign(data + offsets[2 * i],
+                           offsets[2 * i + 1] - offsets[2 * i]);
+    ranges[i].end.assign(data + offsets[2 * i + 1],
+                         offsets[2 * i + 2] - offsets[2 * i + 1]);
+  }
+  return ranges;
+}
+
+void *disgorge_scan_ranges(void *ins, void *query, unsigned long long qlen,
+                           void *bounds, const unsigned long long *offsets,
+                           unsigned long long n, unsigned long long range,
+                           void *lastkey, unsigned long long klen,
+                           void *opts) {
+  if (ins == nullptr) {
+    return nullptr;
+  }
+  disgorge::Instance *instance = (disgorge::Instance *)ins;
+  disgorge::ScanOptions scan_options;
+  if (opts != nullptr) {
+    scan_options = *(disgorge::ScanOptions *)opts;
+  }
+  return instance->scan({(char *)query, qlen},
+                        key_ranges(bounds, offsets, n), range,
+                        {(char *)lastkey, klen}, scan_options);
+}
+
+void *disgorge_multiget(void *ins, void *keys,
+                        const unsigned long long *offsets,
+                        unsigned long long n, void *opts) {
+  if (ins == nullptr) {
+    return nullptr;
+  }
+  disgorge::Instance *instance = (disgorge::Instance *)ins;
+  // key i is keys[offsets[i], offsets[i + 1]), the layout of the values of
+  // a response
+  std::vector<rocksdb::Slice> ks(n);
+  for (unsigned long long i = 0; i < n; i++) {
+    ks[i] = {(char *)keys + offsets[i], offsets[i + 1] - offsets[i]};
+  }
+  if (opts == nullptr) {
+    return instance->multiget(ks);
+  }
+  return instance->multiget(ks, *(disgorge::ScanOptions *)opts);
+}
+
+unsigned long long disgorge_new_set(void *values,
+                                    const unsigned long long *offsets,
+                                    unsigned long long n) {
+  if (values == nullptr && n > 0) {
+    return 0;
+  }
+  if (n > 0 && offsets[n] - offsets[0] > query::IdSet::max_bytes) {
+    return 0;
+  }
+  std::vector<std::string> vs(n);
+  for (unsigned long long i = 0; i < n; i++) {
+    vs[i].assign((char *)values + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+  return query::IdSetRegistry::instance().add(
+      std::make_shared<query::IdSet>(std::move(vs)));
+}
+
+unsigned long long disgorge_new_int_set(const long long *values,
+                                        unsigned long long n) {
+  if (values == nullptr && n > 0) {
+    return 0;
+  }
+  std::vector<int64_t> vs(values, values + n);
+  return query::IdSetRegistry::instance().add(
+      std::make_shared<query::IdSet>(std::move(vs)));
+}
+
+void disgorge_del_set(unsigned long long set) {
+  query::IdSetRegistry::instance().remove(set);
+}
+
+void disgorge_cursor_configure(unsigned long long idle_timeout_ms,
+                               unsigned long long max_cursors) {
+  disgorge::CursorRegistry::instance().configure(idle_timeout_ms,
+                                                 max_cursors);
+}
+
+unsigned long long disgorge_cursor_open(void *ins, void *query,
+                                        unsigned long long qlen, void *start,
+                                        unsigned long long slen, void *end,
+                                        unsigned long long elen, void *opts) {
+  if (ins == nullptr) {
+    return 0;
+  }
+  disgorge::Instance *instance = (disgorge::Instance *)ins;
+  disgorge::ScanOptions scan_options;
+  if (opts != nullptr) {
+    scan_options = *(disgorge::ScanOptions *)opts;
+  }
+  auto cursor =
+      instance->open_cursor({(char *)query, qlen}, {(char *)start, slen},
+                            {(char *)end, elen}, scan_options);
+  if (cursor == nullptr) {
+    return 0;
+  }
+  return disgorge::CursorRegistry::instance().add(cursor);
+}
+
+unsigned long long disgorge_cursor_open_ranges(
+    void *ins, void *query, unsigned long long qlen, void *bounds,
+    const unsigned long long *offsets, unsigned long long n,
+    unsigned long long range, void *lastkey, unsigned long long klen,
+    void *opts) {
+  if (ins == nullptr) {
+    return 0;
+  }
+  disgorge::Instance *instance = (disgorge::Instance *)ins;
+  disgorge::ScanOptions scan_options;
+  if (opts != nullptr) {
+    scan_options = *(disgorge::ScanOptions *)opts;
+  }
+  auto cursor = instance->open_cursor({(char *)query, qlen},
+                                      key_ranges(bounds, offsets, n), range,
+                                      {(char *)lastkey, klen}, scan_options);
+  if (cursor == nullptr) {
+    return 0;
+  }
+  return disgorge::CursorRegistry::instance().add(cursor);
+}
+
+void *disgorge_cursor_next(unsigned long long cursor, void *lastkey,
+                           unsigned long long klen, unsigned long long range,
+                           void *opts) {
+  auto c = disgorge::CursorRegistry::instance().get(cursor);
+  if (c == nullptr) {
+    return nullptr;
+  }
+  if (opts == nullptr) {
+    return c->next(disgorge::ScanOptions(), {(char *)lastkey, klen}, range);
+  }
+  return c->next(*(disgorge::ScanOptions *)opts, {(char *)lastkey, klen},
+                 range);
+}
+
+void disgorge_cursor_close(unsigned long long cursor) {
+  disgorge::CursorRegistry::instance().remove(cursor);
+}
+
+unsigned long long disgorge_cursor_reap() {
+  return disgorge::CursorRegistry::instance().reap();
+}
+
+void *disgorge_new_queue(unsigned long long threads) {
+  try {
+    return new disgorge::CompletionQueue(threads);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+int disgorge_queue_fd(void *queue) {
+  if (queue == nullptr) {
+    return -1;
+  }
+  disgorge::CompletionQueue *q = (disgorge::CompletionQueue *)queue;
+  return q->fd();
+}
+
+int disgorge_queue_poll(void *queue, unsigned long long *tag, void **resp,
+                        unsigned long long *cursor) {
+  if (queue == nullptr) {
+    return 0;
+  }
+  disgorge::CompletionQueue *q = (disgorge::CompletionQueue *)queue;
+  disgorge::Completion done;
+  if (!q->poll(done)) {
+    return 0;
+  }
+  *tag = done.tag;
+  *resp = done.resp;
+  *cursor = done.cursor;
+  return 1;
+}
+
+int disgorge_queue_cancel(void *queue, unsigned long long tag) {
+  if (queue == nullptr) {
+    return 0;
+  }
+  disgorge::CompletionQueue *q = (disgorge::CompletionQueue *)queue;
+  return q->cancel(tag) ? 1 : 0;
+}
+
+void disgorge_del_queue(void *queue) {
+  if (queue == nullptr) {
+    return;
+  }
+  disgorge::CompletionQueue *q = (disgorge::CompletionQueue *)queue;
+  delete q;
+}
+
+int disgorge_submit_scan_ranges(void *queue, unsigned long long tag,
+                                void *ins, void *query,
+                                unsigned long long qlen, void *bounds,
+                                const unsigned long long *offsets,
+                                unsigned long long n, unsigned long long range,
+                                void *lastkey, unsigned long long klen,
+                                void *opts) {
+  if (queue == nullptr || ins == nullptr) {
+    return 0;
+  }
+  disgorge::CompletionQueue *cq = (disgorge::CompletionQueue *)queue;
+  disgorge::Instance *instance = (disgorge::Instance *)ins;
+  disgorge::ScanOptions scan_options;
+  if (opts != nullptr) {
+    scan_options = *(disgorge::ScanOptions *)opts;
+  }
+  // the memory of the caller is only valid during the call
+  std::string q((char *)query, qlen);
+  std::string key((char *)lastkey, klen);
+  auto ranges = key_ranges(bounds, offsets, n);
+  return cq->submit(tag, [=]() {
+    disgorge::Completion done{tag, nullptr, 0};
+    auto cursor =
+        instance->open_cursor(q, ranges, range, key, scan_options);
+    if (cursor != nullptr) {
+      done.cursor = disgorge::CursorRegistry::instance().add(cursor);
+    }
+    if (done.cursor != 0) {
+      done.resp = cursor->next(scan_options, key, range);
+    } else {
+      done.resp = instance->scan(q, ranges, range, key, scan_options);
+    }
+    return done;
+  });
+}
+
+int disgorge_submit_cursor_next(void *queue, unsigned long long tag,
+                                unsigned long long cursor, void *lastkey,
+                                unsigned long long klen,
+                                unsigned long long range, void *opts) {
+  if (queue == nullptr) {
+    return 0;
+  }
+  disgorge::CompletionQueue *cq = (disgorge::CompletionQueue *)queue;
+  disgorge::ScanOptions scan_options;
+  if (opts != nullptr) {
+    scan_options = *(disgorge::ScanOptions *)opts;
+  }
+  // the memory of the caller is only valid during the call
+  std::string key((char *)lastkey, klen);
+  return cq->submit(tag, [=]() {
+    disgorge::Completion done{tag, nullptr, cursor};
+    auto c = disgorge::CursorRegistry::instance().get(cursor);
+    if (c != nullptr) {
+      done.resp = c->next(scan_options, key, range);
+    }
+    return done;
+  });
 }
 
 unsigned long long disgorge_response_size(void *resp) {
@@ -45,6 +439,14 @@ unsigned long long disgorge_response_size(void *resp) {
   return r->size();
 }
 
+unsigned long long disgorge_response_bytes(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->bytes();
+}
+
 int disgorge_response_more(void *resp) {
   if (resp == nullptr) {
     return 0;
@@ -53,6 +455,14 @@ int disgorge_response_more(void *resp) {
   return r->more();
 }
 
+int disgorge_response_ok(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->ok() ? 1 : 0;
+}
+
 int disgorge_check_query(void *query, unsigned long long len) {
   if (query == nullptr || len == 0) {
     return 0;
@@ -69,14 +479,124 @@ const char *disgorge_response_lastkey(void *resp) {
     return 0;
   }
   disgorge::Response *r = (disgorge::Response *)resp;
-  return r->lastkey().c_str();
+  return r->lastkey().data();
 }
+
+unsigned long long disgorge_response_lastkey_len(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->lastkey().size();
+}
+
+unsigned long long disgorge_response_lastrange(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->lastrange();
+}
+
 const char *disgorge_response_value(void *resp, unsigned long long index) {
   if (resp == nullptr) {
     return nullptr;
   }
   disgorge::Response *r = (disgorge::Response *)resp;
-  return r->operator[](index).c_str();
+  return r->operator[](index).data();
+}
+
+unsigned long long disgorge_response_value_len(void *resp,
+                                               unsigned long long index) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->operator[](index).size();
+}
+
+unsigned long long disgorge_response_found(void *resp, void *dst,
+                                           unsigned long long cap) {
+  if (resp == nullptr || dst == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  if (cap < r->size()) {
+    return 0;
+  }
+  unsigned char *p = (unsigned char *)dst;
+  for (size_t i = 0; i < r->size(); i++) {
+    p[i] = r->found(i) ? 1 : 0;
+  }
+  return r->size();
+}
+
+unsigned long long disgorge_response_framed_size(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->framed_size();
+}
+
+unsigned long long disgorge_response_frame(void *resp, void *dst,
+                                           unsigned long long cap) {
+  if (resp == nullptr || dst == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->frame((char *)dst, cap);
+}
+
+unsigned long long disgorge_response_data_size(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->data_size();
+}
+
+unsigned long long disgorge_response_data(void *resp, void *dst,
+                                          unsigned long long cap) {
+  if (resp == nullptr || dst == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->data((char *)dst, cap);
+}
+
+unsigned long long disgorge_response_json_size(void *resp, int raw) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->json_size(raw != 0);
+}
+
+unsigned long long disgorge_response_json(void *resp, void *dst,
+                                          unsigned long long cap, int raw) {
+  if (resp == nullptr || dst == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->json((char *)dst, cap, raw != 0);
+}
+
+unsigned long long disgorge_response_ndjson_size(void *resp) {
+  if (resp == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->ndjson_size();
+}
+
+unsigned long long disgorge_response_ndjson(void *resp, void *dst,
+                                            unsigned long long cap) {
+  if (resp == nullptr || dst == nullptr) {
+    return 0;
+  }
+  disgorge::Response *r = (disgorge::Response *)resp;
+  return r->ndjson((char *)dst, cap);
 }
 
 void disgorge_del_response(void *resp) {
@@ -14,10 +14,68 @@
 // GNU Affero General Public License for more details.
 //
 
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <thread>
 
+#include "cursor.hpp"
+#include "idset.hpp"
+#include "instance.hpp"
+#include "pipeline.hpp"
 #include "query.hpp"
 
+static int failures = 0;
+
+void expect(bool cond, const std::string &what) {
+  if (!cond) {
+    std::cout << "FAIL: " << what << std::endl;
+    failures++;
+  }
+}
+
+// the shards made by make_shard, removed at exit
+static std::vector<std::string> shard_dirs;
+
+// a shard in a fresh directory holding `kv`
+std::string make_shard(
+    const std::vector<std::pair<std::string, std::string>> &kv) {
+  char dir[] = "/tmp/disgorge_test_XXXXXX";
+  if (mkdtemp(dir) == nullptr) {
+    throw std::runtime_error("mkdtemp");
+  }
+  shard_dirs.push_back(dir);
+  rocksdb::Options options;
+  options.create_if_missing = true;
+  rocksdb::DB *db = nullptr;
+  if (!rocksdb::DB::Open(options, dir, &db).ok()) {
+    throw std::runtime_error("open rocksdb error");
+  }
+  for (auto &entry : kv) {
+    db->Put(rocksdb::WriteOptions(), entry.first, entry.second);
+  }
+  db->Close();
+  delete db;
+  return dir;
+}
+
+// every key of the default schema
+const std::string match_all =
+    "{\"type\": 1, \"lower\": 0, \"upper\": 9999999999, "
+    "\"column\": \"timestamp\", \"key\": true}";
+
+std::string ranges_str(const std::vector<disgorge::KeyRange> &ranges) {
+  std::string ret;
+  for (auto &r : ranges) {
+    ret += "[" + r.start + "," + r.end + ")";
+  }
+  return ret;
+}
+
 void test_query() {
   std::string str =
       "{\"type\": 1, \"lower\": 5, \"upper\": 9, \"column\": \"val\"}";
@@ -54,8 +112,641 @@ void test_extract_field() {
   print(e);
 }
 
+void test_key_predicate() {
+  query::KeySchema schema(query::default_key_schema);
+  json key;
+  schema.decode("u123|1700000000", key);
+  expect(key["userId"] == "u123" && key["timestamp"] == 1700000000,
+         "decoded key: " + key.dump());
+
+  std::string str =
+      "{\"type\": 16, "
+      "\"left\": {\"type\": 1, \"lower\": 1700000000, "
+      "\"upper\": 1700003600, \"column\": \"timestamp\", \"key\": true}, "
+      "\"right\": {\"type\": 12, \"value\": \"click\", "
+      "\"column\": \"event\"}}";
+  auto expr = query::parse(str.c_str(), str.size());
+  expect(expr->ExecKey(key) == query::kUnknown, "key in the window");
+  expect(expr->ExecEntry(key, json::parse("{\"event\": \"click\"}")),
+         "entry matches");
+  expect(!expr->ExecEntry(key, json::parse("{\"event\": \"view\"}")),
+         "entry does not match");
+  schema.decode("u123|1600000000", key);
+  expect(expr->ExecKey(key) == query::kFalse, "key out of the window");
+}
+
+using IntDomain = disgorge::Domain<int64_t>;
+using StrDomain = disgorge::Domain<std::string>;
+
+void test_domain() {
+  auto d = IntDomain::intersect(IntDomain::of({1, 5, 9}),
+                                IntDomain::between(4, 9));
+  expect(d.kind == IntDomain::kPoints && d.points == std::set<int64_t>{5, 9},
+         "points and interval");
+  d = IntDomain::intersect(IntDomain::between(1, 6), IntDomain::between(4, 9));
+  expect(d.kind == IntDomain::kInterval && d.lo == 4 && d.hi == 6,
+         "overlapping intervals");
+  d = IntDomain::intersect(IntDomain::between(1, 3), IntDomain::between(4, 9));
+  expect(d.kind == IntDomain::kNone, "disjoint intervals");
+  d = IntDomain::intersect(IntDomain::of({1, 2}), IntDomain::of({3}));
+  expect(d.kind == IntDomain::kNone, "disjoint points");
+  d = IntDomain::intersect(IntDomain::all(), IntDomain::of({3}));
+  expect(d.kind == IntDomain::kPoints, "all and points");
+
+  d = IntDomain::unite(IntDomain::of({1, 2}), IntDomain::of({2, 7}));
+  expect(d.kind == IntDomain::kPoints &&
+             d.points == std::set<int64_t>{1, 2, 7},
+         "points or points");
+  d = IntDomain::unite(IntDomain::of({1}), IntDomain::between(4, 9));
+  expect(d.kind == IntDomain::kInterval && d.lo == 1 && d.hi == 9,
+         "points or interval");
+  d = IntDomain::unite(IntDomain::none(), IntDomain::between(4, 9));
+  expect(d.kind == IntDomain::kInterval, "none or interval");
+  d = IntDomain::unite(IntDomain::all(), IntDomain::between(4, 9));
+  expect(d.kind == IntDomain::kAll, "all or interval");
+
+  // the domains the key predicates of a query leave under AND and OR
+  std::string ts1 =
+      "{\"type\": 1, \"lower\": 10, \"upper\": 20, "
+      "\"column\": \"timestamp\", \"key\": true}";
+  std::string ts2 =
+      "{\"type\": 1, \"lower\": 15, \"upper\": 30, "
+      "\"column\": \"timestamp\", \"key\": true}";
+  std::string users1 =
+      "{\"type\": 15, \"array\": [\"a\", \"b\", \"c\"], "
+      "\"column\": \"userId\", \"key\": true}";
+  std::string users2 =
+      "{\"type\": 9, \"right\": \"b\", \"op\": \"==\", "
+      "\"column\": \"userId\", \"key\": true}";
+  std::string value = "{\"type\": 12, \"value\": \"x\", \"column\": \"tag\"}";
+  auto node = [](int type, const std::string &l, const std::string &r) {
+    std::string str = "{\"type\": " + std::to_string(type) +
+                      ", \"left\": " + l + ", \"right\": " + r + "}";
+    return query::parse(str.c_str(), str.size());
+  };
+  d = disgorge::domain<int64_t>(node(16, ts1, ts2).get(), "timestamp");
+  expect(d.kind == IntDomain::kInterval && d.lo == 15 && d.hi == 20,
+         "and of intervals");
+  d = disgorge::domain<int64_t>(node(17, ts1, ts2).get(), "timestamp");
+  expect(d.kind == IntDomain::kInterval && d.lo == 10 && d.hi == 30,
+         "or of intervals");
+  d = disgorge::domain<int64_t>(node(17, ts1, value).get(), "timestamp");
+  expect(d.kind == IntDomain::kAll, "or with a value predicate");
+  auto u = disgorge::domain<std::string>(node(16, users1, users2).get(),
+                                         "userId");
+  expect(u.kind == StrDomain::kPoints &&
+             u.points == std::set<std::string>{"b"},
+         "and of points");
+  u = disgorge::domain<std::string>(node(17, users2, users1).get(), "userId");
+  expect(u.kind == StrDomain::kPoints && u.points.size() == 3,
+         "or of points");
+}
+
+void test_decimal_bounds() {
+  std::string lo, hi;
+  expect(disgorge::decimal_bounds(IntDomain::between(10, 98), lo, hi) &&
+             lo == "10" && hi == "99",
+         "same digit counts");
+  expect(!disgorge::decimal_bounds(IntDomain::between(10, 99), lo, hi),
+         "upper bound gains a digit");
+  expect(!disgorge::decimal_bounds(IntDomain::between(5, 20), lo, hi),
+         "mixed digit counts");
+  expect(disgorge::decimal_bounds(IntDomain::of({100, 998}), lo, hi) &&
+             lo == "100" && hi == "999",
+         "points");
+  expect(!disgorge::decimal_bounds(IntDomain::between(-5, 5), lo, hi),
+         "negative");
+  expect(!disgorge::decimal_bounds(IntDomain::all(), lo, hi), "unbounded");
+}
+
+void test_ranges() {
+  using disgorge::KeyRange;
+  auto r = disgorge::coalesce({{"c", "d"}, {"a", "b"}, {"b", "c"}});
+  expect(ranges_str(r) == "[a,d)", "touching ranges: " + ranges_str(r));
+  r = disgorge::coalesce({{"a", "d"}, {"b", "c"}, {"c", "e"}, {"x", "x"}});
+  expect(ranges_str(r) == "[a,e)", "overlapping ranges: " + ranges_str(r));
+  r = disgorge::coalesce({{"a", "b"}, {"c", ""}, {"d", "e"}});
+  expect(ranges_str(r) == "[a,b)[c,)", "unbounded range: " + ranges_str(r));
+
+  r = disgorge::intersect({{"a", "c"}, {"e", "g"}}, {{"b", "f"}});
+  expect(ranges_str(r) == "[b,c)[e,f)", "intersect: " + ranges_str(r));
+  r = disgorge::intersect({{"a", "b"}}, {{"b", ""}});
+  expect(r.empty(), "intersect touching: " + ranges_str(r));
+
+  std::vector<KeyRange> users = {
+      {"u1|10", "u1|20"}, {"u2|10", "u2|20"}, {"u3|10", "u3|20"}};
+  r = disgorge::resume(users, 1, "u2|15", false);
+  expect(ranges_str(r) == "[u2|15,u2|20)[u3|10,u3|20)",
+         "forward resume: " + ranges_str(r));
+  r = disgorge::resume(users, 1, "u2|15", true);
+  expect(ranges_str(r) == "[u1|10,u1|20)[u2|10,u2|15)",
+         "reverse resume: " + ranges_str(r));
+  r = disgorge::resume(users, 0, "", false);
+  expect(r.size() == 3, "resume from the start");
+  r = disgorge::resume(users, 3, "u4|10", false);
+  expect(r.empty(), "resume past the ranges");
+
+  // a userId which is a proper prefix of hi sorts its keys after hi
+  expect(disgorge::interval_end("a", "ab") == "b", "prefix of hi");
+  expect(disgorge::interval_end("aa", "ab") == "ac", "no prefix of hi");
+  expect(disgorge::interval_end("", "ab").empty(), "empty lo");
+  expect(disgorge::interval_end("a", "a\xff") == "b", "0xff in hi");
+
+  disgorge::Plan plan;
+  plan.requested = users;
+  expect(disgorge::range_of(plan, "u1|00") == 0, "range before the first");
+  expect(disgorge::range_of(plan, "u2|10") == 1, "range start");
+  expect(disgorge::range_of(plan, "u2|30") == 1, "between ranges");
+  expect(disgorge::range_of(plan, "u3|19") == 2, "last range");
+}
+
+// the keys matching a string interval on the userId are all in the ranges
+// of its plan
+void test_interval_plan() {
+  query::KeySchema schema(query::default_key_schema);
+  std::vector<std::string> keys;
+  for (std::string user : {"", "a", "a0", "aa", "ab", "ab0", "aba", "abz",
+                           "ac", "b", "b~", "ba", "\x7f", "a\xff"}) {
+    for (std::string ts : {"1700000000", "1800000000"}) {
+      keys.push_back(user + "|" + ts);
+    }
+  }
+  std::vector<std::pair<std::string, std::string>> intervals = {
+      {"a", "ab"}, {"aa", "b"}, {"ab", "ab"}, {"", "a"},
+      {"a", "a"},  {"b", "b~"}, {"a0", "ac"}, {"abz", "ba"}};
+  for (auto &interval : intervals) {
+    std::string str = "{\"type\": 3, \"lower\": \"" + interval.first +
+                      "\", \"upper\": \"" + interval.second +
+                      "\", \"column\": \"userId\", \"key\": true}";
+    auto expr = query::parse(str.c_str(), str.size());
+    auto plan = disgorge::plan(expr.get(), schema, {{"", ""}});
+    std::string what = "between(" + interval.first + ", " + interval.second +
+                       ") " + ranges_str(plan.ranges) + ": ";
+    expect(plan.ranged, what + "not ranged");
+    for (auto &key : keys) {
+      json decoded;
+      schema.decode(key, decoded);
+      if (!expr->ExecKey(decoded)) {
+        continue;
+      }
+      bool inside = false;
+      for (auto &r : plan.ranges) {
+        inside = inside || (key >= r.start && (r.end.empty() || key < r.end));
+      }
+      expect(inside, what + key + " outside");
+    }
+  }
+}
+
+// an iterator over sorted keys, the values are the keys
+class VectorIterator : public rocksdb::Iterator {
+ public:
+  explicit VectorIterator(const std::vector<std::string> &keys)
+      : keys_(keys), i_(keys.size()) {}
+  bool Valid() const override { return i_ < keys_.size(); }
+  void SeekToFirst() override { i_ = 0; }
+  void SeekToLast() override { i_ = keys_.empty() ? 0 : keys_.size() - 1; }
+  void Seek(const rocksdb::Slice &target) override {
+    i_ = std::lower_bound(keys_.begin(), keys_.end(), target.ToString()) -
+         keys_.begin();
+  }
+  void SeekForPrev(const rocksdb::Slice &target) override {
+    size_t n = std::upper_bound(keys_.begin(), keys_.end(),
+                                target.ToString()) -
+               keys_.begin();
+    i_ = n == 0 ? keys_.size() : n - 1;
+  }
+  void Next() override { i_++; }
+  void Prev() override { i_ = i_ == 0 ? keys_.size() : i_ - 1; }
+  rocksdb::Slice key() const override { return keys_[i_]; }
+  rocksdb::Slice value() const override { return keys_[i_]; }
+  rocksdb::Status status() const override { return rocksdb::Status::OK(); }
+
+ private:
+  std::vector<std::string> keys_;
+  size_t i_;
+};
+
+std::string walk_str(disgorge::Walk &walk, const std::string &after) {
+  std::string ret;
+  walk.seek_first(after);
+  for (; walk.valid(); walk.next()) {
+    ret += walk.iterator()->key().ToString() + " ";
+  }
+  return ret;
+}
+
+void test_walk() {
+  std::vector<std::string> keys;
+  for (std::string user : {"u1", "u2", "u3", "u4"}) {
+    for (int ts = 10; ts < 14; ts++) {
+      keys.push_back(user + "|" + std::to_string(ts));
+    }
+  }
+  VectorIterator it(keys);
+  query::KeySchema schema(query::default_key_schema);
+  std::vector<disgorge::KeyRange> users = {{"u1|11", "u1|13"},
+                                           {"u3|12", "u3|20"}};
+
+  auto plan = disgorge::plan(nullptr, schema, users);
+  disgorge::Walk forward(&it, plan, false);
+  std::string got = walk_str(forward, "");
+  expect(got == "u1|11 u1|12 u3|12 u3|13 ", "forward walk: " + got);
+  disgorge::Walk reverse(&it, plan, true);
+  got = walk_str(reverse, "");
+  expect(got == "u3|13 u3|12 u1|12 u1|11 ", "reverse walk: " + got);
+
+  // a page which stopped on u1|12 resumes right after it
+  plan = disgorge::plan(nullptr, schema,
+                        disgorge::resume(users, 0, "u1|12", false));
+  disgorge::Walk resumed(&it, plan, false);
+  got = walk_str(resumed, "u1|12");
+  expect(got == "u3|12 u3|13 ", "forward resume: " + got);
+  plan = disgorge::plan(nullptr, schema,
+                        disgorge::resume(users, 1, "u3|13", true));
+  disgorge::Walk reversed(&it, plan, true);
+  got = walk_str(reversed, "u3|13");
+  expect(got == "u3|12 u1|12 u1|11 ", "reverse resume: " + got);
+}
+
+// a skip-scan seeks over the keys of each userId outside of the timestamp
+// window, u2 has none in it
+void test_skip() {
+  std::vector<std::string> keys;
+  for (int ts = 10; ts < 16; ts++) {
+    keys.push_back("u1|" + std::to_string(ts));
+  }
+  for (std::string key : {"u2|10", "u2|11", "u2|18", "u3|12", "u3|13",
+                          "u4|15", "u4|16"}) {
+    keys.push_back(key);
+  }
+  VectorIterator it(keys);
+  query::KeySchema schema(query::default_key_schema);
+  std::string str =
+      "{\"type\": 1, \"lower\": 12, \"upper\": 13, "
+      "\"column\": \"timestamp\", \"key\": true}";
+  auto expr = query::parse(str.c_str(), str.size());
+
+  auto plan = disgorge::plan(expr.get(), schema, {{"", ""}});
+  expect(plan.skip && plan.window_lo == "12" && plan.window_hi == "14",
+         "skip-scan window");
+  disgorge::Walk forward(&it, plan, false);
+  std::string got = walk_str(forward, "");
+  expect(got == "u1|12 u1|13 u3|12 u3|13 ", "forward skip: " + got);
+  disgorge::Walk reverse(&it, plan, true);
+  got = walk_str(reverse, "");
+  expect(got == "u3|13 u3|12 u1|13 u1|12 ", "reverse skip: " + got);
+
+  plan = disgorge::plan(expr.get(), schema,
+                        disgorge::resume({{"", ""}}, 0, "u1|12", false));
+  disgorge::Walk resumed(&it, plan, false);
+  got = walk_str(resumed, "u1|12");
+  expect(got == "u1|13 u3|12 u3|13 ", "forward skip resume: " + got);
+  plan = disgorge::plan(expr.get(), schema,
+                        disgorge::resume({{"", ""}}, 0, "u3|13", true));
+  disgorge::Walk reversed(&it, plan, true);
+  got = walk_str(reversed, "u3|13");
+  expect(got == "u3|12 u1|13 u1|12 ", "reverse skip resume: " + got);
+
+  // the seeks count against the budget: the walk stops on the key it
+  // would have sought from
+  plan = disgorge::plan(expr.get(), schema, {{"", ""}});
+  disgorge::Walk bounded(&it, plan, false);
+  disgorge::Budget budget(0, 2, nullptr);
+  bounded.limit(&budget);
+  got = walk_str(bounded, "");
+  expect(got == "u1|12 u1|13 " && bounded.stopped() &&
+             bounded.stopped_at() == "u1|14",
+         "skip on max_keys: " + got + "stopped at " + bounded.stopped_at());
+
+  // the skipped windows are no way around a cancelled scan
+  disgorge::Cancel cancel;
+  cancel.cancel();
+  for (size_t parallelism : {0, 4}) {
+    disgorge::Budget cancelled(0, 0, &cancel);
+    disgorge::ScanOptions scan_options;
+    scan_options.parallelism = parallelism;
+    disgorge::Walk walk(&it, plan, false);
+    walk.seek_first("");
+    size_t collected = 0;
+    disgorge::drain(
+        walk, expr, scan_options,
+        [&](const rocksdb::Slice &, const rocksdb::Slice &) {
+          collected++;
+          return true;
+        },
+        cancelled);
+    expect(collected == 0 && cancelled.exhausted() &&
+               cancelled.lastkey() == "u1|10",
+           "cancelled skip-scan stopped at " + cancelled.lastkey());
+  }
+}
+
+// VectorIterator with a json value, counting how many values are read
+class ValueIterator : public VectorIterator {
+ public:
+  explicit ValueIterator(const std::vector<std::string> &keys)
+      : VectorIterator(keys), reads(0) {}
+  rocksdb::Slice value() const override {
+    reads++;
+    return value_;
+  }
+  mutable size_t reads;
+
+ private:
+  std::string value_ = "{\"event\": \"click\"}";
+};
+
+// the entries a key predicate rejects have their value never read, nor
+// parsed, on the calling thread and through the pipeline
+void test_key_before_value() {
+  std::vector<std::string> keys;
+  for (int ts = 10; ts < 20; ts++) {
+    keys.push_back("u1|" + std::to_string(ts));
+  }
+  query::KeySchema schema(query::default_key_schema);
+  std::string str =
+      "{\"type\": 16, "
+      "\"left\": {\"type\": 1, \"lower\": 12, \"upper\": 13, "
+      "\"column\": \"timestamp\", \"key\": true}, "
+      "\"right\": {\"type\": 12, \"value\": \"click\", "
+      "\"column\": \"event\"}}";
+  auto expr = query::parse(str.c_str(), str.size());
+  // without a plan every key is walked and left to the predicate
+  auto plan = disgorge::plan(nullptr, schema, {{"", ""}});
+  for (size_t parallelism : {0, 4}) {
+    ValueIterator it(keys);
+    disgorge::ScanOptions scan_options;
+    scan_options.parallelism = parallelism;
+    disgorge::Budget budget;
+    disgorge::Walk walk(&it, plan, false);
+    walk.seek_first("");
+    std::string got;
+    rocksdb::Status status = disgorge::drain(
+        walk, expr, scan_options,
+        [&](const rocksdb::Slice &key, const rocksdb::Slice &) {
+          got += key.ToString() + " ";
+          return true;
+        },
+        budget);
+    expect(status.ok() && got == "u1|12 u1|13 ",
+           "key predicate, parallelism " + std::to_string(parallelism) +
+               ": " + got);
+    expect(it.reads == 2, "values read, parallelism " +
+                              std::to_string(parallelism) + ": " +
+                              std::to_string(it.reads));
+  }
+}
+
+void test_cursor_reap() {
+  disgorge::Instance ins(make_shard({{"u1|1700000000", "{}"}}));
+  auto &registry = disgorge::CursorRegistry::instance();
+  registry.configure(20, 0);
+  uint64_t id = registry.add(ins.open_cursor(match_all, "", ""));
+  expect(id != 0 && registry.get(id) != nullptr, "cursor registered");
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  expect(registry.reap() == 1, "idle cursor reaped");
+  expect(registry.get(id) == nullptr, "reaped cursor gone");
+  registry.configure(disgorge::default_cursor_idle_ms, 0);
+}
+
+// value i of a counted shard, {"v": "<i on 4 digits>"}
+std::string counted(int i) {
+  std::string v = std::to_string(i);
+  return "{\"v\": \"" + std::string(4 - v.size(), '0') + v + "\"}";
+}
+
+// a shard of `n` keys of u1, the value of key i being counted(i)
+std::string make_counted_shard(int n) {
+  std::vector<std::pair<std::string, std::string>> kv;
+  for (int i = 0; i < n; i++) {
+    kv.push_back({"u1|" + std::to_string(1700000000 + i), counted(i)});
+  }
+  return make_shard(kv);
+}
+
+// the values from counted(0) to counted(2000)
+const std::string first_counted =
+    "{\"type\": 3, \"lower\": \"0000\", \"upper\": \"2000\", "
+    "\"column\": \"v\"}";
+
+// the values of every page of a scan of `ranges`, each page resuming where
+// the previous one stopped; `pages` counts them
+std::vector<std::string> scan_pages(
+    disgorge::Instance &ins, const std::string &query,
+    const std::vector<disgorge::KeyRange> &ranges,
+    const disgorge::ScanOptions &scan_options, size_t *pages) {
+  std::vector<std::string> ret;
+  std::string lastkey;
+  size_t lastrange = 0;
+  *pages = 0;
+  for (;;) {
+    std::unique_ptr<disgorge::Response> resp(
+        ins.scan(query, ranges, lastrange, lastkey, scan_options));
+    (*pages)++;
+    for (size_t i = 0; i < resp->size(); i++) {
+      ret.push_back((*resp)[i].ToString());
+    }
+    if (resp->more() == 0 || *pages > 10000) {
+      return ret;
+    }
+    // no lastkey: the page ended where it began
+    if (!resp->lastkey().empty()) {
+      lastkey = resp->lastkey();
+      lastrange = resp->lastrange();
+    }
+  }
+}
+
+// the pipeline collects in scan order whatever the workers finish first,
+// over more entries than its window holds, and the entry a full page held
+// back opens the next page
+void test_pipeline() {
+  disgorge::Instance ins(make_counted_shard(3000));
+  std::vector<disgorge::KeyRange> all = {{"", ""}};
+  disgorge::ScanOptions sequential;
+  sequential.limit_rows = 100000;
+  size_t pages = 0;
+  auto want = scan_pages(ins, first_counted, all, sequential, &pages);
+  expect(want.size() == 2001 && pages == 1, "sequential scan");
+  bool ordered = true;
+  for (size_t i = 0; i < want.size(); i++) {
+    ordered = ordered && want[i] == counted(i);
+  }
+  expect(ordered, "sequential scan in key order");
+
+  disgorge::ScanOptions parallel = sequential;
+  parallel.parallelism = 4;
+  expect(scan_pages(ins, first_counted, all, parallel, &pages) == want,
+         "pipeline in key order");
+
+  parallel.limit_bytes = 1000;
+  auto paged = scan_pages(ins, first_counted, all, parallel, &pages);
+  expect(paged == want && pages > 10,
+         "byte-limited pipeline pages: " + std::to_string(pages));
+}
+
+// only the first value of a page may go over limit_bytes, so that paging
+// always makes progress; with a request page, the first of the request
+void test_limit_bytes() {
+  std::string big = "{\"s\": \"" + std::string(200, 'x') + "\"}";
+  disgorge::Instance ins(make_shard({{"u1|1700000000", big},
+                                     {"u1|1700000001", counted(1)},
+                                     {"u1|1700000002", counted(2)}}));
+  std::vector<disgorge::KeyRange> all = {{"", ""}};
+  disgorge::ScanOptions scan_options;
+  scan_options.limit_bytes = 50;
+  std::unique_ptr<disgorge::Response> first(
+      ins.scan(match_all, all, 0, "", scan_options));
+  expect(first->size() == 1 && (*first)[0] == big && first->more() == 1,
+         "a first value over the limit");
+  std::unique_ptr<disgorge::Response> rest(ins.scan(
+      match_all, all, first->lastrange(), first->lastkey(), scan_options));
+  expect(rest->size() == 2 && rest->more() == 0, "the values under it");
+
+  // another scan of the request took the first value of the page
+  disgorge::RequestPage taken;
+  taken.fill();
+  scan_options.request_page = &taken;
+  std::unique_ptr<disgorge::Response> held(
+      ins.scan(match_all, all, 0, "", scan_options));
+  expect(held->size() == 0 && held->more() == 1 && held->lastkey().empty(),
+         "a value over the limit held back for the next page");
+  disgorge::RequestPage fresh;
+  scan_options.request_page = &fresh;
+  std::unique_ptr<disgorge::Response> claimed(
+      ins.scan(match_all, all, 0, "", scan_options));
+  expect(claimed->size() == 1 && (*claimed)[0] == big,
+         "the first value of the request page");
+}
+
+// a page which spent its budget ends at the last key examined, matched or
+// not, and the next page resumes right after it
+void test_budget_lastkey() {
+  disgorge::Instance ins(make_counted_shard(100));
+  std::vector<disgorge::KeyRange> all = {{"", ""}};
+  std::string none =
+      "{\"type\": 3, \"lower\": \"9000\", \"upper\": \"9999\", "
+      "\"column\": \"v\"}";
+  for (size_t parallelism : {0, 4}) {
+    std::string with = " with parallelism " + std::to_string(parallelism);
+    disgorge::ScanOptions scan_options;
+    scan_options.parallelism = parallelism;
+    scan_options.max_keys = 5;
+    std::unique_ptr<disgorge::Response> empty(
+        ins.scan(none, all, 0, "", scan_options));
+    expect(empty->size() == 0 && empty->more() == 1 &&
+               empty->lastkey() == "u1|1700000004",
+           "no match, stopped at " + empty->lastkey() + with);
+
+    std::unique_ptr<disgorge::Response> page(
+        ins.scan(first_counted, all, 0, "", scan_options));
+    expect(page->size() == 5 && page->more() == 1 &&
+               page->lastkey() == "u1|1700000004",
+           "all matched, stopped at " + page->lastkey() + with);
+    std::unique_ptr<disgorge::Response> next(ins.scan(
+        first_counted, all, page->lastrange(), page->lastkey(), scan_options));
+    expect(next->size() == 5 && (*next)[0] == counted(5) &&
+               next->lastkey() == "u1|1700000009",
+           "resumed after the budget" + with);
+  }
+}
+
+// a cancelled scan stops within a stride of keys and ends its page like a
+// spent budget does, so nothing is lost when the request is retried
+void test_cancel() {
+  disgorge::Instance ins(make_counted_shard(3000));
+  std::vector<disgorge::KeyRange> all = {{"", ""}};
+  disgorge::Cancel cancel;
+  cancel.cancel();
+  for (size_t parallelism : {0, 4}) {
+    std::string with = " with parallelism " + std::to_string(parallelism);
+    disgorge::ScanOptions scan_options;
+    scan_options.parallelism = parallelism;
+    scan_options.limit_rows = 100000;
+    scan_options.cancel = &cancel;
+    std::unique_ptr<disgorge::Response> cut(
+        ins.scan(match_all, all, 0, "", scan_options));
+    expect(cut->size() <= disgorge::budget_check_stride && cut->more() == 1 &&
+               !cut->lastkey().empty(),
+           "cancelled after " + std::to_string(cut->size()) + with);
+    scan_options.cancel = nullptr;
+    std::unique_ptr<disgorge::Response> rest(ins.scan(
+        match_all, all, cut->lastrange(), cut->lastkey(), scan_options));
+    expect(cut->size() + rest->size() == 3000 && rest->more() == 0,
+           "retried after the cancel" + with);
+  }
+}
+
+void test_scan_start() {
+  disgorge::Instance ins(make_shard({{"u1|1700000000", "{\"a\": 1}"},
+                                     {"u1|1700000001", "{\"a\": 2}"}}));
+  std::unique_ptr<disgorge::Response> single(
+      ins.scan(match_all, "u1|1700000000", "u1|1700000002"));
+  expect(single->size() == 2, "single range takes the key at start");
+  std::vector<disgorge::KeyRange> ranges = {
+      {"u1|1700000000", "u1|1700000002"}};
+  std::unique_ptr<disgorge::Response> first(
+      ins.scan(match_all, ranges, 0, ""));
+  expect(first->size() == 2, "ranges take the key at start");
+  std::unique_ptr<disgorge::Response> resumed(
+      ins.scan(match_all, ranges, 0, "u1|1700000000"));
+  expect(resumed->size() == 1 && (*resumed)[0] == "{\"a\": 2}",
+         "resumed right after lastkey");
+}
+
+void test_multiget() {
+  disgorge::Instance ins(make_shard(
+      {{"u1|1700000000", "{\"a\": 1}"}, {"u2|1700000000", ""}}));
+  std::vector<rocksdb::Slice> keys = {"u3|1700000000", "u1|1700000000",
+                                      "u2|1700000000"};
+  std::unique_ptr<disgorge::Response> resp(ins.multiget(keys));
+  expect(resp->size() == 3, "a value per key");
+  expect(!resp->found(0) && (*resp)[0].empty(), "missing key not found");
+  expect(resp->found(1) && (*resp)[1] == "{\"a\": 1}", "value in key order");
+  expect(resp->found(2) && (*resp)[2].empty(), "empty value found");
+}
+
+void test_idset_handles() {
+  auto &registry = query::IdSetRegistry::instance();
+  auto set = std::make_shared<query::IdSet>(
+      std::vector<std::string>{"u2", "u1", "u2"});
+  expect(set->size() == 2 && set->contains("u1"), "sorted unique strings");
+  for (int i = 0; i < 4; i++) {
+    uint64_t id = registry.add(set);
+    expect(id != 0 && id <= query::IdSetRegistry::max_handle,
+           "handle fits a json number");
+    expect(registry.get(id) == set, "set by handle");
+    registry.remove(id);
+    expect(registry.get(id) == nullptr, "removed set gone");
+  }
+}
+
 int main() {
   test_query();
   test_extract_field();
+  test_key_predicate();
+  test_domain();
+  test_decimal_bounds();
+  test_ranges();
+  test_interval_plan();
+  test_walk();
+  test_skip();
+  test_key_before_value();
+  test_cursor_reap();
+  test_pipeline();
+  test_limit_bytes();
+  test_budget_lastkey();
+  test_cancel();
+  test_scan_start();
+  test_multiget();
+  test_idset_handles();
+  for (auto &dir : shard_dirs) {
+    std::filesystem::remove_all(dir);
+  }
+  if (failures > 0) {
+    std::cout << failures << " failed" << std::endl;
+    return 1;
+  }
   return 0;
 }
\ No newline at end of file
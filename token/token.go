@@ -0,0 +1,172 @@
+// Package token encodes the progress of a paged query over its shards into
+// a compact continuation token, which clients send back instead of the whole
+// shard list.
+//
+// A token names the shards it has started by the digest of their path, so
+// it still decodes after shards were added to the window: those have not
+// been started. It is also bound to the digest of the scans of its request
+// (query, users and direction), since its resume points are meaningless to
+// any other. Layout, version 3:
+//
+//	version    byte
+//	digest     8 bytes, little endian
+//	count      uvarint
+//	count times:
+//	  shard    8 bytes little endian, the digest of its path
+//	  state    byte, the status in the low bits and hasMore in stateMore
+//	  and for shards in progress:
+//	  cursor   uvarint
+//	  range    uvarint
+//	  lastkey  uvarint length and bytes
+//
+// Shards which are not in the token have not been started.
+package token
+
+import (
+	"disgorge/api"
+	"encoding/binary"
+	"errors"
+	"hash/fnv"
+)
+
+const version = 3
+const stateMore = 0x80
+
+var (
+	ErrInvalid = errors.New("invalid continuation token")
+	ErrShard   = errors.New("continuation token of a shard which is gone")
+	ErrDigest  = errors.New("continuation token of another query")
+)
+
+const header = 9
+
+// shardDigest names a shard in a token
+func shardDigest(path string) uint64 {
+	h := fnv.New64a()
+	h.Write([]byte(path))
+	return h.Sum64()
+}
+
+func appendUint64(buf []byte, v uint64) []byte {
+	var tmp [8]byte
+	binary.LittleEndian.PutUint64(tmp[:], v)
+	return append(buf, tmp[:]...)
+}
+
+func appendUvarint(buf []byte, v uint64) []byte {
+	var tmp [binary.MaxVarintLen64]byte
+	n := binary.PutUvarint(tmp[:], v)
+	return append(buf, tmp[:n]...)
+}
+
+// Encode cuts the token of shards scanned by the request of digest
+func Encode(digest uint64, shards []*api.Shard) []byte {
+	started := make([]int, 0, len(shards))
+	for i := 0; i < len(shards); i++ {
+		if shards[i].Status != api.ShardStatus_NotStarted {
+			started = append(started, i)
+		}
+	}
+
+	buf := make([]byte, 0, header+8+16*len(started))
+	buf = append(buf, version)
+	buf = appendUint64(buf, digest)
+	buf = appendUvarint(buf, uint64(len(started)))
+	for _, i := range started {
+		shard := shards[i]
+		buf = appendUint64(buf, shardDigest(shard.Path))
+		state := byte(shard.Status)
+		if shard.HasMore {
+			state |= stateMore
+		}
+		buf = append(buf, state)
+		if shard.Status != api.ShardStatus_InProgress {
+			continue
+		}
+		buf = appendUvarint(buf, shard.Cursor)
+		buf = appendUvarint(buf, uint64(shard.Lastrange))
+		buf = appendUvarint(buf, uint64(len(shard.Lastkey)))
+		buf = append(buf, shard.Lastkey...)
+	}
+	return buf
+}
+
+// Decode restores the progress of token onto shards, scanned by the request
+// of digest, whose shards are expected not to be started yet. A shard of the
+// token which is not among shards any more fails with ErrShard unless it was
+// finished, since the values it had left are gone.
+func Decode(token []byte, digest uint64, shards []*api.Shard) error {
+	if len(token) < header || token[0] != version {
+		return ErrInvalid
+	}
+	if binary.LittleEndian.Uint64(token[1:9]) != digest {
+		return ErrDigest
+	}
+	buf := token[header:]
+	uvarint := func() (uint64, error) {
+		v, n := binary.Uvarint(buf)
+		if n <= 0 {
+			return 0, ErrInvalid
+		}
+		buf = buf[n:]
+		return v, nil
+	}
+
+	count, err := uvarint()
+	if err != nil {
+		return err
+	}
+	index := make(map[uint64]int, len(shards))
+	for i := 0; i < len(shards); i++ {
+		index[shardDigest(shards[i].Path)] = i
+	}
+	for k := uint64(0); k < count; k++ {
+		if len(buf) < 9 {
+			return ErrInvalid
+		}
+		i, found := index[binary.LittleEndian.Uint64(buf)]
+		state := buf[8]
+		buf = buf[9:]
+		status := api.ShardStatus(state &^ stateMore)
+		if _, ok := api.ShardStatus_name[int32(status)]; !ok {
+			return ErrInvalid
+		}
+		if !found {
+			// nothing is lost with a shard which was finished
+			if status == api.ShardStatus_Finished {
+				continue
+			}
+			return ErrShard
+		}
+		shard := shards[i]
+		shard.Status = status
+		shard.HasMore = state&stateMore != 0
+		shard.Cursor = 0
+		shard.Lastrange = 0
+		shard.Lastkey = nil
+		if status != api.ShardStatus_InProgress {
+			continue
+		}
+		if shard.Cursor, err = uvarint(); err != nil {
+			return err
+		}
+		lastrange, err := uvarint()
+		if err != nil {
+			return err
+		}
+		shard.Lastrange = uint32(lastrange)
+		n, err := uvarint()
+		if err != nil {
+			return err
+		}
+		if n > uint64(len(buf)) {
+			return ErrInvalid
+		}
+		shard.Lastkey = append([]byte(nil), buf[:n]...)
+		buf = buf[n:]
+	}
+	if len(buf) != 0 {
+		return ErrInvalid
+	}
+	return nil
+}
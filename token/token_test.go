@@ -0,0 +1,92 @@
+package token
+
+import (
+	"bytes"
+	"disgorge/api"
+	"testing"
+)
+
+func newShards(paths []string) []*api.Shard {
+	shards := make([]*api.Shard, len(paths))
+	for i := 0; i < len(paths); i++ {
+		shards[i] = &api.Shard{Status: api.ShardStatus_NotStarted, Path: paths[i], HasMore: true}
+	}
+	return shards
+}
+
+func TestToken_RoundTrip(t *testing.T) {
+	paths := []string{"/data/a/1700000000", "/data/a/1700003600", "/data/b/1700003600", "/data/b/1700007200"}
+	shards := newShards(paths)
+	shards[0].Status = api.ShardStatus_Finished
+	shards[0].HasMore = false
+	shards[2].Status = api.ShardStatus_InProgress
+	shards[2].Cursor = 1 << 60
+	shards[2].Lastrange = 3
+	shards[2].Lastkey = []byte("u1\x00|1700003601")
+
+	token := Encode(42, shards)
+	got := newShards(paths)
+	if err := Decode(token, 42, got); err != nil {
+		t.Fatal(err)
+	}
+	for i := 0; i < len(paths); i++ {
+		if got[i].Status != shards[i].Status || got[i].HasMore != shards[i].HasMore ||
+			got[i].Cursor != shards[i].Cursor || got[i].Lastrange != shards[i].Lastrange ||
+			!bytes.Equal(got[i].Lastkey, shards[i].Lastkey) {
+			t.Fatalf("shard %d: got %v, want %v", i, got[i], shards[i])
+		}
+	}
+}
+
+func TestToken_ShardAdded(t *testing.T) {
+	paths := []string{"/data/a/1700000000", "/data/a/1700003600"}
+	shards := newShards(paths)
+	shards[0].Status = api.ShardStatus_Finished
+	shards[0].HasMore = false
+	shards[1].Status = api.ShardStatus_InProgress
+	shards[1].Lastkey = []byte("u1|1700003601")
+	token := Encode(42, shards)
+
+	// a host shipped a shard of the first hour after page 1 was cut
+	got := newShards([]string{"/data/a/1700000000", "/data/b/1700000000", "/data/a/1700003600"})
+	if err := Decode(token, 42, got); err != nil {
+		t.Fatal(err)
+	}
+	if got[0].Status != api.ShardStatus_Finished || got[0].HasMore {
+		t.Fatalf("finished shard: %v", got[0])
+	}
+	if got[1].Status != api.ShardStatus_NotStarted || !got[1].HasMore {
+		t.Fatalf("added shard: %v", got[1])
+	}
+	if got[2].Status != api.ShardStatus_InProgress || string(got[2].Lastkey) != "u1|1700003601" {
+		t.Fatalf("shard in progress: %v", got[2])
+	}
+}
+
+func TestToken_Rejects(t *testing.T) {
+	paths := []string{"/data/a/1700000000", "/data/a/1700003600"}
+	shards := newShards(paths)
+	shards[0].Status = api.ShardStatus_Finished
+	shards[0].HasMore = false
+	shards[1].Status = api.ShardStatus_InProgress
+	shards[1].Lastkey = []byte("u1|1700003601")
+	token := Encode(42, shards)
+
+	if err := Decode(token, 42, newShards(paths[:1])); err != ErrShard {
+		t.Fatalf("shard gone: %v", err)
+	}
+	if err := Decode(token, 42, newShards(paths[1:])); err != nil {
+		t.Fatalf("finished shard gone: %v", err)
+	}
+	if err := Decode(token, 43, newShards(paths)); err != ErrDigest {
+		t.Fatalf("other query: %v", err)
+	}
+	for n := 0; n < len(token); n++ {
+		if err := Decode(token[:n], 42, newShards(paths)); err == nil {
+			t.Fatalf("truncated to %d bytes: no error", n)
+		}
+	}
+	if err := Decode(append(token, 0), 42, newShards(paths)); err != ErrInvalid {
+		t.Fatalf("trailing bytes: %v", err)
+	}
+}
@@ -0,0 +1,178 @@
+package warehouse
+
+/*
+#cgo darwin,amd64 pkg-config: ${SRCDIR}/../third/disgorge-darwin-amd64.pc
+#cgo darwin,arm64 pkg-config: ${SRCDIR}/../third/disgorge-darwin-arm64.pc
+#cgo linux,amd64 pkg-config:  ${SRCDIR}/../third/disgorge-linux-amd64.pc
+#include <stdlib.h>
+#include "disgorge.h"
+*/
+import "C"
+
+import (
+	"context"
+	"disgorge/api"
+	"os"
+	"sync"
+	"syscall"
+	"time"
+	"unsafe"
+
+	"github.com/uopensail/ulib/zlog"
+	"go.uber.org/zap"
+)
+
+// completion is a page libdisgorge scanned on one of its threads
+type completion struct {
+	resp   unsafe.Pointer
+	cursor uint64
+}
+
+// asyncQueue runs the scans on the bounded thread pool of libdisgorge: the
+// goroutine of a scan parks until its page is there, instead of holding an
+// OS thread in a cgo call, and one goroutine polls all the completions
+type asyncQueue struct {
+	ptr     unsafe.Pointer
+	mu      sync.Mutex
+	next    uint64
+	waiting map[uint64]chan completion
+	// broken once the fd cannot be read: no job is submitted any more, the
+	// scans run on the calling thread
+	broken bool
+}
+
+// queue is nil when the scans run on the calling thread
+var queue *asyncQueue
+
+// drainInterval is how often a broken queue polls for the completions of the
+// jobs still running
+const drainInterval = time.Millisecond
+
+func newAsyncQueue(threads int) *asyncQueue {
+	ptr := C.disgorge_new_queue(C.ulonglong(threads))
+	if ptr == nil {
+		return nil
+	}
+	// the fd is libdisgorge's, the file gets a copy of its own
+	fd, err := syscall.Dup(int(C.disgorge_queue_fd(ptr)))
+	if err != nil {
+		C.disgorge_del_queue(ptr)
+		return nil
+	}
+	q := &asyncQueue{ptr: ptr, waiting: make(map[uint64]chan completion)}
+	// the fd is nonblocking, so reads park on the netpoller
+	go q.run(os.NewFile(uintptr(fd), "disgorge-queue"))
+	return q
+}
+
+func (q *asyncQueue) run(f *os.File) {
+	defer f.Close()
+	buf := make([]byte, 64)
+	for {
+		if _, err := f.Read(buf); err != nil {
+			zlog.LOG.Error("completion queue read error, scans run synchronously", zap.Error(err))
+			break
+		}
+		q.poll()
+	}
+
+	q.mu.Lock()
+	q.broken = true
+	q.mu.Unlock()
+	// the jobs submitted before still use the instance and the cancel token
+	// of their callers, who wait for them: their completions are polled
+	// until none is left
+	ticker := time.NewTicker(drainInterval)
+	defer ticker.Stop()
+	for {
+		q.poll()
+		q.mu.Lock()
+		left := len(q.waiting)
+		q.mu.Unlock()
+		if left == 0 {
+			return
+		}
+		<-ticker.C
+	}
+}
+
+// poll hands every completion there is to its waiter
+func (q *asyncQueue) poll() {
+	var tag, cursor C.ulonglong
+	var resp unsafe.Pointer
+	for C.disgorge_queue_poll(q.ptr, &tag, &resp, &cursor) == 1 {
+		q.mu.Lock()
+		ch := q.waiting[uint64(tag)]
+		delete(q.waiting, uint64(tag))
+		q.mu.Unlock()
+		ch <- completion{resp: resp, cursor: uint64(cursor)}
+	}
+}
+
+// wait submits a job under a fresh tag and waits for its completion. It is
+// false when the job did not run on the queue, because the queue is broken,
+// the job was refused, or ctx was done before it started: the caller runs it
+// itself then, which ends at once on a cancelled token. A job that has
+// started is waited for even when ctx is done, it stops at its next check of
+// the cancel token and still uses the memory of the caller until then.
+func (q *asyncQueue) wait(ctx context.Context, submit func(tag C.ulonglong) C.int) (completion, bool) {
+	ch := make(chan completion, 1)
+	q.mu.Lock()
+	if q.broken {
+		q.mu.Unlock()
+		return completion{}, false
+	}
+	q.next++
+	tag := q.next
+	q.waiting[tag] = ch
+	q.mu.Unlock()
+	if submit(C.ulonglong(tag)) == 0 {
+		q.mu.Lock()
+		delete(q.waiting, tag)
+		q.mu.Unlock()
+		return completion{}, false
+	}
+	select {
+	case done := <-ch:
+		return done, true
+	case <-ctx.Done():
+	}
+	if C.disgorge_queue_cancel(q.ptr, C.ulonglong(tag)) == 1 {
+		q.mu.Lock()
+		delete(q.waiting, tag)
+		q.mu.Unlock()
+		return completion{}, false
+	}
+	return <-ch, true
+}
+
+// cursorNext reads the next page of the cursor of shard, see cursorNext; it
+// is false when the page is to be read on the calling thread
+func (q *asyncQueue) cursorNext(ctx context.Context, shard *api.Shard, opts unsafe.Pointer) (unsafe.Pointer, bool) {
+	done, ok := q.wait(ctx, func(tag C.ulonglong) C.int {
+		return C.disgorge_submit_cursor_next(q.ptr, tag, C.ulonglong(shard.Cursor),
+			keyPtr(shard.Lastkey), C.ulonglong(len(shard.Lastkey)), C.ulonglong(shard.Lastrange), opts)
+	})
+	return done.resp, ok
+}
+
+// scanRanges reads the first page of a shard, or the first one since its
+// cursor was lost, and keeps the cursor of the next pages in the shard; it is
+// false when the page is to be read on the calling thread
+func (q *asyncQueue) scanRanges(ctx context.Context, ins unsafe.Pointer, query string, ranges []keyRange, shard *api.Shard, opts unsafe.Pointer) (unsafe.Pointer, bool) {
+	bounds := make([]string, 0, 2*len(ranges))
+	for i := 0; i < len(ranges); i++ {
+		bounds = append(bounds, ranges[i].start, ranges[i].end)
+	}
+	buf, offs := packKeys(bounds)
+
+	done, ok := q.wait(ctx, func(tag C.ulonglong) C.int {
+		return C.disgorge_submit_scan_ranges(q.ptr, tag, ins, unsafe.Pointer(&str2bytes(query)[0]), C.ulonglong(len(query)),
+			unsafe.Pointer(&buf[0]), &offs[0], C.ulonglong(len(ranges)), C.ulonglong(shard.Lastrange),
+			keyPtr(shard.Lastkey), C.ulonglong(len(shard.Lastkey)), opts)
+	})
+	if ok {
+		shard.Cursor = done.cursor
+	}
+	return done.resp, ok
+}
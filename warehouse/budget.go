@@ -0,0 +1,74 @@
+package warehouse
+
+import "sync/atomic"
+
+// budget is what is left of the limits of a request, shared by the scans
+// of its shards: each scan reserves its share of what is left and gives
+// back what it did not use, so that the page never goes over the limits
+type budget struct {
+	limitRows  int64
+	rows       int64
+	bytes      int64
+	shareRows  int64
+	shareBytes int64
+}
+
+// newBudget splits limitRows and limitBytes (0: no byte limit) between
+// up to `workers` scans running at once
+func newBudget(limitRows, limitBytes uint64, workers int) *budget {
+	if workers <= 0 {
+		workers = 1
+	}
+	return &budget{
+		limitRows:  int64(limitRows),
+		rows:       int64(limitRows),
+		bytes:      int64(limitBytes),
+		shareRows:  (int64(limitRows) + int64(workers) - 1) / int64(workers),
+		shareBytes: (int64(limitBytes) + int64(workers) - 1) / int64(workers),
+	}
+}
+
+// reserve takes the limits of the next scan off the budget, bytes being 0
+// without a byte limit; false once the budget is used up
+func (b *budget) reserve() (rows int64, bytes int64, ok bool) {
+	if rows = take(&b.rows, b.shareRows); rows == 0 {
+		return 0, 0, false
+	}
+	if b.shareBytes > 0 {
+		if bytes = take(&b.bytes, b.shareBytes); bytes == 0 {
+			atomic.AddInt64(&b.rows, rows)
+			return 0, 0, false
+		}
+	}
+	return rows, bytes, true
+}
+
+// settle gives back what a scan which reserved rows and bytes did not use
+// of them, having taken usedRows values of usedBytes
+func (b *budget) settle(rows, bytes int64, usedRows, usedBytes uint64) {
+	atomic.AddInt64(&b.rows, rows-int64(usedRows))
+	if b.shareBytes > 0 {
+		atomic.AddInt64(&b.bytes, bytes-int64(usedBytes))
+	}
+}
+
+// used is the number of rows the scans took
+func (b *budget) used() uint64 {
+	return uint64(b.limitRows - atomic.LoadInt64(&b.rows))
+}
+
+// take reserves up to n off a budget, 0 once it is used up
+func take(v *int64, n int64) int64 {
+	for {
+		left := atomic.LoadInt64(v)
+		if left <= 0 {
+			return 0
+		}
+		if n > left {
+			n = left
+		}
+		if atomic.CompareAndSwapInt64(v, left, left-n) {
+			return n
+		}
+	}
+}
@@ -0,0 +1,93 @@
+package warehouse
+
+import (
+	"sync"
+	"sync/atomic"
+	"testing"
+)
+
+// a request over 10 shards of 30 rows of 10 bytes, scanned by 4 workers
+// which reserve, scan and settle the way Query does
+func runShared(t *testing.T, limitRows, limitBytes uint64) (rows, bytes uint64) {
+	const shards, shardRows, rowBytes = 10, 30, 10
+	left := newBudget(limitRows, limitBytes, 4)
+	var reservedRows, reservedBytes, takenRows, takenBytes int64
+	next := int64(-1)
+	var wg sync.WaitGroup
+	for w := 0; w < 4; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				if int(atomic.AddInt64(&next, 1)) >= shards {
+					return
+				}
+				r, b, ok := left.reserve()
+				if !ok {
+					return
+				}
+				// what all the scans running at once may take stays within
+				// the limits
+				if n := atomic.AddInt64(&reservedRows, r); uint64(n) > limitRows {
+					t.Errorf("%d rows reserved at once, limit %d", n, limitRows)
+				}
+				if n := atomic.AddInt64(&reservedBytes, b); limitBytes > 0 && uint64(n) > limitBytes {
+					t.Errorf("%d bytes reserved at once, limit %d", n, limitBytes)
+				}
+				n := int64(shardRows)
+				if n > r {
+					n = r
+				}
+				if limitBytes > 0 && n*rowBytes > b {
+					n = b / rowBytes
+				}
+				atomic.AddInt64(&takenRows, n)
+				atomic.AddInt64(&takenBytes, n*rowBytes)
+				atomic.AddInt64(&reservedRows, -r)
+				atomic.AddInt64(&reservedBytes, -b)
+				left.settle(r, b, uint64(n), uint64(n*rowBytes))
+			}
+		}()
+	}
+	wg.Wait()
+	if left.used() != uint64(takenRows) {
+		t.Fatalf("used %d rows, the scans took %d", left.used(), takenRows)
+	}
+	return uint64(takenRows), uint64(takenBytes)
+}
+
+func TestBudget_SharedRows(t *testing.T) {
+	rows, _ := runShared(t, 100, 0)
+	if rows > 100 {
+		t.Fatalf("%d rows over a limit of 100", rows)
+	}
+	// what a shard leaves goes to the next one: with enough data the page
+	// is full
+	if rows, _ := runShared(t, 300, 0); rows != 300 {
+		t.Fatalf("%d rows of 300", rows)
+	}
+}
+
+func TestBudget_SharedBytes(t *testing.T) {
+	rows, bytes := runShared(t, 1000, 250)
+	if bytes > 250 || rows > 25 {
+		t.Fatalf("%d rows of %d bytes over a limit of 250 bytes", rows, bytes)
+	}
+}
+
+func TestBudget_UsedUp(t *testing.T) {
+	left := newBudget(10, 0, 4)
+	rows, bytes, ok := left.reserve()
+	if !ok || rows != 3 || bytes != 0 {
+		t.Fatalf("first share: %d rows, %d bytes, %v", rows, bytes, ok)
+	}
+	left.settle(rows, bytes, 3, 0)
+	for i := 0; i < 3; i++ {
+		if _, _, ok := left.reserve(); !ok {
+			t.Fatalf("share %d refused", i+1)
+		}
+	}
+	if _, _, ok := left.reserve(); ok {
+		t.Fatal("reserved past the limit")
+	}
+}
@@ -0,0 +1,127 @@
+package warehouse
+
+/*
+#cgo darwin,amd64 pkg-config: ${SRCDIR}/../third/disgorge-darwin-amd64.pc
+#cgo darwin,arm64 pkg-config: ${SRCDIR}/../third/disgorge-darwin-arm64.pc
+#cgo linux,amd64 pkg-config:  ${SRCDIR}/../third/disgorge-linux-amd64.pc
+#include <stdlib.h>
+#include "disgorge.h"
+*/
+import "C"
+
+import (
+	"bytes"
+	"context"
+	"disgorge/api"
+	"disgorge/token"
+	"errors"
+	"time"
+
+	"github.com/uopensail/ulib/prome"
+)
+
+var errWindow = errors.New("fail to list the shards")
+
+// Chunk is a page of one shard sent by QueryStream, encoded in the format
+// of the stream; Token resumes right after it, see QueryStream
+type Chunk struct {
+	Code  int32
+	Path  string
+	Body  []byte
+	Rows  uint64
+	Token []byte
+	// on the last chunk, every shard is finished
+	Done bool
+}
+
+// QueryStream scans the shards of the window one after another and sends
+// every page as soon as it is read: req.LimitRows and req.LimitBytes bound
+// a page rather than the whole stream. The next page is read once send
+// returned, so a client which reads slowly holds the scan back through the
+// flow control of its transport. The stream ends with a chunk without rows
+// carrying the final token, also when it stops on the deadline of the
+// request; a stream cut off earlier resumes from the token of the last
+// chunk received.
+//
+// A send which returned does not mean the client got the chunk, so any
+// chunk may be the last one received. Its token holds the cursors of the
+// shards, which have moved on with the later chunks, next to the lastkey
+// and lastrange of the chunk: a cursor only serves the position of the page
+// it handed out last, so one resumed from an older chunk is refused and the
+// shard seeks from the lastkey of the token, nothing is skipped.
+func QueryStream(ctx context.Context, req *api.Request, format Format, send func(*Chunk) error) error {
+	stat := prome.NewStat("warehouse.QueryStream")
+	defer stat.End()
+
+	w, code := resolve(req)
+	if w == nil {
+		stat.MarkErr()
+		if code == 409 {
+			return send(&Chunk{Code: code})
+		}
+		return errWindow
+	}
+
+	limitRows := uint64(maxCount)
+	if req.LimitRows > 0 {
+		limitRows = uint64(req.LimitRows)
+	}
+	var deadline time.Time
+	if req.TimeoutMs > 0 {
+		deadline = time.Now().Add(time.Duration(req.TimeoutMs) * time.Millisecond)
+	}
+
+	cancel := C.disgorge_new_cancel()
+	defer C.disgorge_del_cancel(cancel)
+	defer watch(ctx, cancel)()
+	opts := scanOptions(req, w.digest, cancel)
+	defer C.disgorge_del_scan_options(opts)
+
+	count := uint64(0)
+	done := true
+shards:
+	for i := 0; i < len(w.shards); i++ {
+		shard := w.shards[i]
+		for shard.HasMore && shard.Status != api.ShardStatus_Finished &&
+			shard.Status != api.ShardStatus_Error {
+			if err := ctx.Err(); err != nil {
+				stat.MarkErr()
+				return err
+			}
+			remainingMs := int64(0)
+			if req.TimeoutMs > 0 {
+				remainingMs = time.Until(deadline).Milliseconds()
+				if remainingMs <= 0 {
+					done = false
+					break shards
+				}
+			}
+			C.disgorge_scan_options_set_limits(opts, C.ulonglong(limitRows), C.ulonglong(req.LimitBytes))
+			C.disgorge_scan_options_set_budget(opts, C.ulonglong(remainingMs), C.ulonglong(req.MaxKeys))
+			lastkey, lastrange := shard.Lastkey, shard.Lastrange
+			p := scan(ctx, req.Query, w.ranges, shard, w.status[i], opts, format)
+			count += p.rows
+			if p.rows > 0 {
+				chunk := &Chunk{
+					Code:  200,
+					Path:  shard.Path,
+					Body:  p.body,
+					Rows:  p.rows,
+					Token: token.Encode(w.digest, w.shards),
+				}
+				if err := send(chunk); err != nil {
+					stat.MarkErr()
+					return err
+				}
+			} else if shard.HasMore && shard.Lastrange == lastrange &&
+				bytes.Equal(shard.Lastkey, lastkey) {
+				// the shard did not move, e.g. it cannot be opened: the
+				// token keeps it for a later call
+				done = false
+				break
+			}
+		}
+	}
+	stat.SetCounter(int(count))
+	return send(&Chunk{Code: 200, Token: token.Encode(w.digest, w.shards), Done: done})
+}
@@ -12,14 +12,21 @@ package warehouse
 import "C"
 
 import (
+	"context"
 	"disgorge/api"
+	"disgorge/catalog"
 	"disgorge/config"
+	"disgorge/token"
+	"encoding/binary"
 	"fmt"
+	"hash/fnv"
 	"math/rand"
-	"os"
-	"path"
 	"reflect"
+	"sort"
 	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
 	"time"
 	"unsafe"
 
@@ -28,7 +35,6 @@ import (
 	"go.uber.org/zap"
 )
 
-const success = "SUCCESS"
 const interval int64 = 3600
 const maxCount = 1000
 
@@ -43,17 +49,74 @@ func str2bytes(s string) (b []byte) {
 	return b
 }
 
-func scan(query, start, end string, shard *api.Shard, status bool) []string {
-	stat := prome.NewStat("warehouse.scan")
-	defer stat.End()
-	if shard == nil || shard.Status == api.ShardStatus_Finished ||
-		shard.Status == api.ShardStatus_Error ||
-		(!shard.HasMore) {
-		zlog.LOG.Info("shard status check fail")
+// bytes2str views b as a string, b must not change afterwards
+func bytes2str(b []byte) string {
+	/* #nosec G103 */
+	return *(*string)(unsafe.Pointer(&b))
+}
+
+// keyPtr points C at a key, which may be empty or hold any byte, and goes
+// over with its length
+func keyPtr(key []byte) unsafe.Pointer {
+	if len(key) == 0 {
 		return nil
 	}
+	return unsafe.Pointer(&key[0])
+}
 
-	shard.Status = api.ShardStatus_InProgress
+// shardCatalog knows the shards of the work dir
+var shardCatalog *catalog.Catalog
+
+// defaultCursorIdle is the idle timeout of libdisgorge's cursors when
+// cursor_idle_timeout is not set
+const defaultCursorIdle = time.Minute
+
+// reapCursors releases the idle cursors every half idle timeout: libdisgorge
+// only reaps them when a scan uses the registry, so on a quiet server they
+// would keep their shard, its secondary directory and a snapshot
+func reapCursors(idle time.Duration) {
+	ticker := time.NewTicker(idle / 2)
+	defer ticker.Stop()
+	for range ticker.C {
+		C.disgorge_cursor_reap()
+	}
+}
+
+// Init applies the process wide settings of libdisgorge
+func Init() {
+	// megabytes of block cache shared by all the shards, 0 keeps the default
+	C.disgorge_block_cache_configure(C.ulonglong(config.AppConf.BlockCacheSize) << 20)
+	C.disgorge_cursor_configure(C.ulonglong(config.AppConf.CursorIdleTimeout*1000),
+		C.ulonglong(config.AppConf.MaxCursors))
+	idle := time.Duration(config.AppConf.CursorIdleTimeout) * time.Second
+	if idle <= 0 {
+		idle = defaultCursorIdle
+	}
+	go reapCursors(idle)
+	shardCatalog = catalog.New(config.AppConf.WorkDir, interval,
+		time.Duration(config.AppConf.CatalogRescan)*time.Second)
+	if !shardCatalog.Watching() {
+		zlog.LOG.Warn("no inotify, new shards are seen at the next rescan")
+	}
+	queue = newAsyncQueue(config.AppConf.ScanThreads)
+	if queue == nil {
+		zlog.LOG.Error("fail to start the scan threads, scans run on the calling thread")
+	}
+}
+
+// setKeySchema tells libdisgorge how keys decode for the key predicates,
+// its default is the upstream userId|timestamp:int layout
+func setKeySchema(opts unsafe.Pointer) {
+	schema := config.AppConf.KeySchema
+	if schema == "" {
+		return
+	}
+	if C.disgorge_scan_options_set_key_schema(opts, unsafe.Pointer(&str2bytes(schema)[0]), C.ulonglong(len(schema))) == 0 {
+		zlog.LOG.Error("invalid key schema", zap.String("key_schema", schema))
+	}
+}
+
+func open(shardPath string, status bool) unsafe.Pointer {
 	secondary := ""
 
 	if status {
@@ -62,148 +125,645 @@ func scan(query, start, end string, shard *api.Shard, status bool) []string {
 		secondary = fmt.Sprintf("/tmp/%d-%d", ts, idx)
 	}
 
-	ins := C.disgorge_open(unsafe.Pointer(&str2bytes(shard.Path)[0]), C.ulonglong(len(shard.Path)),
-		unsafe.Pointer(&str2bytes(secondary)[0]), C.ulonglong(len(secondary)))
-	defer C.disgorge_close(ins)
+	// a shard which is not ready opens read only, without a secondary path
+	return C.disgorge_open(keyPtr(str2bytes(shardPath)), C.ulonglong(len(shardPath)),
+		keyPtr(str2bytes(secondary)), C.ulonglong(len(secondary)))
+}
 
-	if ins == nil {
-		stat.MarkErr()
-		zlog.LOG.Error("fail to open rocksdb", zap.String("path", shard.Path))
-		return nil
+// keyRange is [start, end) of keys, an empty end is unbounded
+type keyRange struct {
+	start string
+	end   string
+}
+
+// packKeys lays keys out back to back, key i being buf[offs[i], offs[i+1]),
+// the layout libdisgorge takes key lists in
+func packKeys(keys []string) ([]byte, []C.ulonglong) {
+	offs := make([]C.ulonglong, len(keys)+1)
+	for i := 0; i < len(keys); i++ {
+		offs[i+1] = offs[i] + C.ulonglong(len(keys[i]))
+	}
+	buf := make([]byte, 0, int(offs[len(keys)])+1)
+	for i := 0; i < len(keys); i++ {
+		buf = append(buf, keys[i]...)
 	}
+	buf = append(buf, 0)
+	return buf, offs
+}
 
-	startKey := start
+// openRanges starts the scan of the key ranges of a shard in one pass: a
+// cursor, or a single page when the cursor cannot be registered
+func openRanges(ins unsafe.Pointer, query string, ranges []keyRange, shard *api.Shard, opts unsafe.Pointer) unsafe.Pointer {
+	bounds := make([]string, 0, 2*len(ranges))
+	for i := 0; i < len(ranges); i++ {
+		bounds = append(bounds, ranges[i].start, ranges[i].end)
+	}
+	buf, offs := packKeys(bounds)
 
-	if len(shard.Lastkey) > 0 {
-		startKey = shard.Lastkey
+	cursor := C.disgorge_cursor_open_ranges(ins, unsafe.Pointer(&str2bytes(query)[0]), C.ulonglong(len(query)),
+		unsafe.Pointer(&buf[0]), &offs[0], C.ulonglong(len(ranges)), C.ulonglong(shard.Lastrange),
+		keyPtr(shard.Lastkey), C.ulonglong(len(shard.Lastkey)), opts)
+	if cursor != 0 {
+		shard.Cursor = uint64(cursor)
+		return cursorNext(shard, opts)
 	}
+	return C.disgorge_scan_ranges(ins, unsafe.Pointer(&str2bytes(query)[0]), C.ulonglong(len(query)),
+		unsafe.Pointer(&buf[0]), &offs[0], C.ulonglong(len(ranges)), C.ulonglong(shard.Lastrange),
+		keyPtr(shard.Lastkey), C.ulonglong(len(shard.Lastkey)), opts)
+}
 
-	resp := C.disgorge_scan(ins, unsafe.Pointer(&str2bytes(query)[0]), C.ulonglong(len(query)),
-		unsafe.Pointer(&str2bytes(startKey)[0]), C.ulonglong(len(startKey)),
-		unsafe.Pointer(&str2bytes(end)[0]), C.ulonglong(len(end)))
-	defer C.disgorge_del_response(resp)
-	ret := make([]string, 0, maxCount)
+// cursorNext reads the next page of the cursor of shard, nil when the cursor
+// is gone, scans another query or is not at the lastkey of shard
+func cursorNext(shard *api.Shard, opts unsafe.Pointer) unsafe.Pointer {
+	return C.disgorge_cursor_next(C.ulonglong(shard.Cursor),
+		keyPtr(shard.Lastkey), C.ulonglong(len(shard.Lastkey)), C.ulonglong(shard.Lastrange), opts)
+}
+
+// Format is how the values of a page leave libdisgorge
+type Format int
+
+const (
+	// FormatData is the api.Data message in protobuf wire format
+	FormatData Format = iota
+	// FormatJSON is a json array of the values as strings
+	FormatJSON
+	// FormatRawJSON is a json array of the values as json documents
+	FormatRawJSON
+	// FormatNDJSON is the values as json documents, one a line
+	FormatNDJSON
+)
+
+// page is a page of a shard, encoded by libdisgorge
+type page struct {
+	rows  uint64
+	bytes uint64
+	body  []byte
+}
+
+// scan reads the next page of a shard. The ranges are walked with one
+// iterator, their resume point being the range and the key the previous
+// page stopped at.
+func scan(ctx context.Context, query string, ranges []keyRange, shard *api.Shard, status bool, opts unsafe.Pointer, format Format) page {
+	stat := prome.NewStat("warehouse.scan")
+	defer stat.End()
+	if shard == nil || shard.Status == api.ShardStatus_Finished ||
+		shard.Status == api.ShardStatus_Error ||
+		(!shard.HasMore) {
+		zlog.LOG.Info("shard status check fail")
+		return page{}
+	}
+
+	shard.Status = api.ShardStatus_InProgress
+
+	var resp unsafe.Pointer
+	if shard.Cursor != 0 {
+		// continue from where the previous page stopped; the cursor is gone
+		// if it idled out or was opened by another process, and refuses a
+		// shard which is not where it left off
+		queued := false
+		if queue != nil {
+			resp, queued = queue.cursorNext(ctx, shard, opts)
+		}
+		if !queued {
+			resp = cursorNext(shard, opts)
+		}
+		if resp == nil {
+			shard.Cursor = 0
+		}
+	}
+
+	if resp == nil {
+		ins := open(shard.Path, status)
+		defer C.disgorge_close(ins)
+
+		if ins == nil {
+			stat.MarkErr()
+			zlog.LOG.Error("fail to open rocksdb", zap.String("path", shard.Path))
+			return page{}
+		}
 
-	if int(C.disgorge_response_more(resp)) == 1 {
+		queued := false
+		if queue != nil {
+			// the instance is closed once the page is there
+			resp, queued = queue.scanRanges(ctx, ins, query, ranges, shard, opts)
+		}
+		if !queued {
+			// the same scan as the queue's: a first page takes the ranges
+			// from their start, later ones resume right after lastkey
+			resp = openRanges(ins, query, ranges, shard, opts)
+		}
+	}
+	defer C.disgorge_del_response(resp)
+	if int(C.disgorge_response_ok(resp)) == 0 {
+		// the rest of the shard cannot be read, the client is told so
+		// rather than the shard being done
+		stat.MarkErr()
+		zlog.LOG.Error("fail to scan rocksdb", zap.String("path", shard.Path))
+		shard.HasMore = false
+		shard.Lastkey = nil
+		shard.Lastrange = 0
+		shard.Status = api.ShardStatus_Error
+		if shard.Cursor != 0 {
+			C.disgorge_cursor_close(C.ulonglong(shard.Cursor))
+			shard.Cursor = 0
+		}
+	} else if int(C.disgorge_response_more(resp)) == 1 {
 		shard.HasMore = true
-		shard.Lastkey = C.GoString(C.disgorge_response_lastkey(resp))
+		// no lastkey: the page ended where it began, e.g. its first value
+		// went to another shard of the request, and the shard stays there
+		if n := int(C.disgorge_response_lastkey_len(resp)); n > 0 {
+			// keys are binary, they go over by length
+			shard.Lastkey = C.GoBytes(unsafe.Pointer(C.disgorge_response_lastkey(resp)), C.int(n))
+			shard.Lastrange = uint32(C.disgorge_response_lastrange(resp))
+		}
 	} else {
 		shard.HasMore = false
-		shard.Lastkey = ""
+		shard.Lastkey = nil
+		shard.Lastrange = 0
 		shard.Status = api.ShardStatus_Finished
+		if shard.Cursor != 0 {
+			C.disgorge_cursor_close(C.ulonglong(shard.Cursor))
+			shard.Cursor = 0
+		}
 	}
 
-	size := uint64(C.disgorge_response_size(resp))
+	return encodePage(resp, format)
+}
+
+// encodePage has libdisgorge encode the page in the format the server
+// answers with, straight into one Go buffer which is sent as is
+func encodePage(resp unsafe.Pointer, format Format) page {
+	p := page{
+		rows:  uint64(C.disgorge_response_size(resp)),
+		bytes: uint64(C.disgorge_response_bytes(resp)),
+	}
+	if p.rows == 0 {
+		return p
+	}
+	raw := C.int(0)
+	if format == FormatRawJSON {
+		raw = 1
+	}
+	var n C.ulonglong
+	switch format {
+	case FormatData:
+		n = C.disgorge_response_data_size(resp)
+	case FormatNDJSON:
+		n = C.disgorge_response_ndjson_size(resp)
+	default:
+		n = C.disgorge_response_json_size(resp, raw)
+	}
+	p.body = make([]byte, int(n))
+	switch format {
+	case FormatData:
+		n = C.disgorge_response_data(resp, unsafe.Pointer(&p.body[0]), n)
+	case FormatNDJSON:
+		n = C.disgorge_response_ndjson(resp, unsafe.Pointer(&p.body[0]), n)
+	default:
+		n = C.disgorge_response_json(resp, unsafe.Pointer(&p.body[0]), n, raw)
+	}
+	p.body = p.body[:int(n)]
+	return p
+}
 
-	for i := uint64(0); i < size; i++ {
-		ptr := C.disgorge_response_value(resp, C.ulonglong(i))
-		ret = append(ret, C.GoString(ptr))
+// pageValues hands the values of a page over at once: libdisgorge frames
+// them straight into one Go buffer, which the strings slice without another
+// copy
+func pageValues(resp unsafe.Pointer) []string {
+	size := int(C.disgorge_response_size(resp))
+	if size == 0 {
+		return nil
+	}
+	n := C.disgorge_response_framed_size(resp)
+	buf := make([]byte, int(n))
+	if C.disgorge_response_frame(resp, unsafe.Pointer(&buf[0]), n) != n {
+		return nil
+	}
+	page := bytes2str(buf)
+	ret := make([]string, size)
+	for i, p := 0, 0; i < size; i++ {
+		l := int(binary.LittleEndian.Uint32(buf[p:]))
+		ret[i] = page[p+4 : p+4+l]
+		p += 4 + l
 	}
 	return ret
 }
 
-func Query(req *api.Request) *api.Response {
-	stat := prome.NewStat("warehouse.Query")
-	defer stat.End()
+// watch trips the cancel token of libdisgorge once ctx is done, so running
+// scans stop early; the returned func stops watching and must be called
+// before the token is deleted
+func watch(ctx context.Context, cancel unsafe.Pointer) func() {
+	stop := make(chan struct{})
+	done := make(chan struct{})
+	go func() {
+		defer close(done)
+		select {
+		case <-ctx.Done():
+			C.disgorge_cancel(cancel)
+		case <-stop:
+		}
+	}()
+	return func() {
+		close(stop)
+		<-done
+	}
+}
+
+// window is what a request covers: its shards in scan order with their
+// progress and open status, and its key ranges
+type window struct {
+	shards []*api.Shard
+	status []bool
+	ranges []keyRange
+	digest uint64
+}
+
+// scanDigest identifies the scans of a request, which the cursors of its
+// shards are bound to
+func scanDigest(query string, ranges []keyRange, reverse bool) uint64 {
+	h := fnv.New64a()
+	h.Write([]byte(query))
+	for i := 0; i < len(ranges); i++ {
+		h.Write([]byte{0})
+		h.Write([]byte(ranges[i].start))
+		h.Write([]byte{0})
+		h.Write([]byte(ranges[i].end))
+	}
+	if reverse {
+		h.Write([]byte{1})
+	} else {
+		h.Write([]byte{0})
+	}
+	return h.Sum64()
+}
 
-	workdir := config.AppConf.WorkDir
-	// build dict
+// resolve finds the window of a request, nil with the code of the response
+// when it cannot
+func resolve(req *api.Request) (*window, int32) {
+	// build dict, a token carries the progress instead
 	shardDict := make(map[string]*api.Shard, len(req.Shards))
-	for i := 0; i < len(req.Shards); i++ {
-		shardDict[req.Shards[i].Path] = req.Shards[i]
+	if len(req.Token) == 0 {
+		for i := 0; i < len(req.Shards); i++ {
+			shardDict[req.Shards[i].Path] = req.Shards[i]
+		}
 	}
 
 	startTs := req.Start - 10
 	endTs := req.End + 10
 	shards := make([]*api.Shard, 0)
 	status := make([]bool, 0)
+	tss := make([]int64, 0)
 
-	// list dirs
-	files, err := os.ReadDir(workdir)
+	dirs, err := shardCatalog.Overlapping(startTs, endTs)
 	if err != nil {
-		stat.MarkErr()
-		zlog.LOG.Error("list dir error", zap.String("workdir", workdir))
-		return nil
+		zlog.LOG.Error("list dir error", zap.String("workdir", config.AppConf.WorkDir))
+		return nil, 500
 	}
 
-	// filter and list the shards and open status
-	for i := 0; i < len(files); i++ {
-		if !files[i].IsDir() {
-			continue
+	// keep the open status of the shards
+	for i := 0; i < len(dirs); i++ {
+		ts := dirs[i].Ts
+		shard, ok := shardDict[dirs[i].Path]
+		if !ok {
+			shard = &api.Shard{
+				Status:  api.ShardStatus_NotStarted,
+				Path:    dirs[i].Path,
+				HasMore: true,
+				Lastkey: nil,
+			}
 		}
+		shards = append(shards, shard)
+		tss = append(tss, ts)
+		status = append(status, dirs[i].Ready)
+	}
 
-		ip := files[i].Name()
-		ipPath := path.Join(workdir, ip)
-		subFiles, err := os.ReadDir(ipPath)
-		if err != nil {
-			continue
+	// visit the shards in time order, newest first for reverse scans, so
+	// that the first pages hold the earliest (latest) matches
+	order := make([]int, len(shards))
+	for i := 0; i < len(order); i++ {
+		order[i] = i
+	}
+	sort.SliceStable(order, func(a, b int) bool {
+		if req.Reverse {
+			return tss[order[a]] > tss[order[b]]
 		}
+		return tss[order[a]] < tss[order[b]]
+	})
+	sortedShards := make([]*api.Shard, len(shards))
+	sortedStatus := make([]bool, len(shards))
+	for i := 0; i < len(order); i++ {
+		sortedShards[i] = shards[order[i]]
+		sortedStatus[i] = status[order[i]]
+	}
+	shards, status = sortedShards, sortedStatus
 
-		for j := 0; j < len(subFiles); j++ {
-			if !subFiles[j].IsDir() {
-				continue
+	// do query: one key range per user, libdisgorge walks them in key order
+	users := req.UserIds
+	if req.UserId != "" {
+		users = append([]string{req.UserId}, users...)
+	}
+	ranges := []keyRange{{}}
+	if len(users) > 0 {
+		ranges = make([]keyRange, len(users))
+		for i := 0; i < len(users); i++ {
+			ranges[i] = keyRange{
+				start: fmt.Sprintf("%s|%d", users[i], req.Start),
+				end:   fmt.Sprintf("%s|%d", users[i], req.End+1),
 			}
+		}
+	}
 
-			ts, err := strconv.ParseInt(subFiles[j].Name(), 10, 64)
-			if err != nil {
-				continue
-			}
+	digest := scanDigest(req.Query, ranges, req.Reverse)
+	if len(req.Token) > 0 {
+		if err := token.Decode(req.Token, digest, shards); err != nil {
+			// a shard of the token is gone, or it is the token of another
+			// query
+			zlog.LOG.Warn("continuation token rejected", zap.Error(err))
+			return nil, 409
+		}
+	}
 
-			if !((ts <= startTs && startTs <= ts+interval) ||
-				(ts <= endTs && endTs <= ts+interval)) {
-				continue
-			}
+	return &window{shards: shards, status: status, ranges: ranges, digest: digest}, 200
+}
 
-			shardPath := path.Join(ipPath, subFiles[j].Name())
-			shard, ok := shardDict[shardPath]
-			if !ok {
-				shard = &api.Shard{
-					Status:  api.ShardStatus_NotStarted,
-					Path:    shardPath,
-					HasMore: true,
-					Lastkey: "",
+// Query scans the shards of the window for the next page. The values of
+// shard i come in pages[i], encoded in `format`: the api.Data message with
+// FormatData, which the server sends as the data of the response, a json
+// array otherwise.
+func Query(ctx context.Context, req *api.Request, format Format) (resp *api.Response, pages [][]byte) {
+	stat := prome.NewStat("warehouse.Query")
+	defer stat.End()
+
+	w, code := resolve(req)
+	if w == nil {
+		stat.MarkErr()
+		if code == 409 {
+			return &api.Response{Code: code}, nil
+		}
+		return nil, nil
+	}
+	shards, status, ranges, digest := w.shards, w.status, w.ranges, w.digest
+
+	resp = &api.Response{
+		Shards: shards,
+		Code:   200,
+	}
+	// the shards left for later get an empty page
+	pages = make([][]byte, len(shards))
+
+	// the budget is shared by all the shards of the request, up to
+	// query_concurrency of which are scanned at once
+	limitRows := uint64(maxCount)
+	if req.LimitRows > 0 {
+		limitRows = uint64(req.LimitRows)
+	}
+	limitBytes := req.LimitBytes
+	var deadline time.Time
+	if req.TimeoutMs > 0 {
+		deadline = time.Now().Add(time.Duration(req.TimeoutMs) * time.Millisecond)
+	}
+	workers := config.AppConf.QueryConcurrency
+	// newest first only holds when the shards fill the page one after the
+	// other
+	if workers <= 0 || req.Reverse {
+		workers = 1
+	}
+	if workers > len(shards) && len(shards) > 0 {
+		workers = len(shards)
+	}
+	left := newBudget(limitRows, limitBytes, workers)
+
+	cancel := C.disgorge_new_cancel()
+	defer C.disgorge_del_cancel(cancel)
+	defer watch(ctx, cancel)()
+	// only the first value of the whole page may go over limitBytes
+	requestPage := C.disgorge_new_request_page()
+	defer C.disgorge_del_request_page(requestPage)
+
+	// the workers take the shards in order, shard i is only touched by the
+	// worker which took it
+	next := int64(-1)
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			opts := scanOptions(req, digest, cancel)
+			defer C.disgorge_del_scan_options(opts)
+			C.disgorge_scan_options_set_request_page(opts, requestPage)
+
+			for {
+				i := int(atomic.AddInt64(&next, 1))
+				if i >= len(shards) || ctx.Err() != nil {
+					return
 				}
+				if shards[i].Status == api.ShardStatus_Error ||
+					shards[i].Status == api.ShardStatus_Finished {
+					continue
+				}
+				// a shard which is out of time or budget keeps its resume
+				// point, the client picks it up with the next call
+				remainingMs := int64(0)
+				if req.TimeoutMs > 0 {
+					remainingMs = time.Until(deadline).Milliseconds()
+					if remainingMs <= 0 {
+						return
+					}
+				}
+				rows, bytes, ok := left.reserve()
+				if !ok {
+					return
+				}
+				C.disgorge_scan_options_set_limits(opts, C.ulonglong(rows), C.ulonglong(bytes))
+				C.disgorge_scan_options_set_budget(opts, C.ulonglong(remainingMs), C.ulonglong(req.MaxKeys))
+				p := scan(ctx, req.Query, ranges, shards[i], status[i], opts, format)
+				pages[i] = p.body
+				left.settle(rows, bytes, p.rows, p.bytes)
 			}
-			shards = append(shards, shard)
-			if _, err := os.Stat(path.Join(ipPath, subFiles[j].Name(), success)); os.IsNotExist(err) {
-				status = append(status, false)
-			} else {
-				status = append(status, true)
-			}
-		}
+		}()
+	}
+	wg.Wait()
+	count := left.used()
+	stat.SetCounter(int(count))
+	resp.Token = token.Encode(digest, shards)
+	if req.Compact || len(req.Token) > 0 {
+		resp.Shards = nil
 	}
+	return resp, pages
+}
 
-	// do query
-	var startPrefix, endPrefix string
-	if req.UserId != "" {
-		startPrefix = fmt.Sprintf("%s|%d", req.UserId, req.Start)
-		endPrefix = fmt.Sprintf("%s|%d", req.UserId, req.End+1)
+// scanOptions are the options of the scans of a request, the limits and
+// the budget are set per scan
+func scanOptions(req *api.Request, digest uint64, cancel unsafe.Pointer) unsafe.Pointer {
+	opts := C.disgorge_new_scan_options()
+	C.disgorge_scan_options_set_digest(opts, C.ulonglong(digest))
+	C.disgorge_scan_options_set_profile(opts, C.int(req.Profile))
+	C.disgorge_scan_options_set_parallelism(opts, C.ulonglong(config.AppConf.ScanParallelism))
+	setKeySchema(opts)
+	if req.Reverse {
+		C.disgorge_scan_options_set_reverse(opts, 1)
 	}
+	C.disgorge_scan_options_set_cancel(opts, cancel)
+	return opts
+}
 
-	resp := &api.Response{
-		Data:   make([]*api.Data, len(shards)),
-		Shards: shards,
-		Code:   200,
+// keyTs extracts ts from a userId|ts key
+func keyTs(key string) (int64, bool) {
+	i := strings.IndexByte(key, '|')
+	if i < 0 {
+		return 0, false
+	}
+	field := key[i+1:]
+	if j := strings.IndexByte(field, '|'); j >= 0 {
+		field = field[:j]
 	}
+	ts, err := strconv.ParseInt(field, 10, 64)
+	if err != nil {
+		return 0, false
+	}
+	return ts, true
+}
 
-	count := 0
+func multiget(dir catalog.Shard, keys []string, opts unsafe.Pointer) ([]string, []bool) {
+	stat := prome.NewStat("warehouse.multiget")
+	defer stat.End()
+
+	ins := open(dir.Path, dir.Ready)
+	defer C.disgorge_close(ins)
+	if ins == nil {
+		stat.MarkErr()
+		zlog.LOG.Error("fail to open rocksdb", zap.String("path", dir.Path))
+		return nil, nil
+	}
+
+	// the keys go over the way values come back: back to back in one buffer
+	buf, offs := packKeys(keys)
+	resp := C.disgorge_multiget(ins, unsafe.Pointer(&buf[0]), &offs[0], C.ulonglong(len(keys)), opts)
+	defer C.disgorge_del_response(resp)
 
-	for i := 0; i < len(shards); i++ {
-		if shards[i].Status == api.ShardStatus_Error ||
-			shards[i].Status == api.ShardStatus_Finished {
+	values := pageValues(resp)
+	if len(values) != len(keys) {
+		stat.MarkErr()
+		return nil, nil
+	}
+	found := make([]byte, len(keys))
+	if C.disgorge_response_found(resp, unsafe.Pointer(&found[0]), C.ulonglong(len(found))) != C.ulonglong(len(found)) {
+		stat.MarkErr()
+		return nil, nil
+	}
+	ok := make([]bool, len(keys))
+	for i := 0; i < len(found); i++ {
+		ok[i] = found[i] != 0
+	}
+	return values, ok
+}
+
+// MultiGet fetches values by exact key. Each key is looked up in the shards
+// of its hour, one batch per shard; found[i] tells whether keys[i] is
+// anywhere, value i being empty when it is not.
+func MultiGet(ctx context.Context, req *api.MultiGetRequest) *api.MultiGetResponse {
+	stat := prome.NewStat("warehouse.MultiGet")
+	defer stat.End()
+
+	// group the keys by the shards which may hold them, a key of an hour
+	// may live in the shard of any host
+	var dirs []catalog.Shard
+	var groups [][]int
+	index := make(map[string]int)
+	for i := 0; i < len(req.Keys); i++ {
+		ts, ok := keyTs(req.Keys[i])
+		if !ok {
 			continue
 		}
-		resp.Data[i] = &api.Data{
-			Items: make([]string, 0, maxCount),
+		shards, err := shardCatalog.Overlapping(ts, ts)
+		if err != nil {
+			stat.MarkErr()
+			zlog.LOG.Error("list dir error", zap.String("workdir", config.AppConf.WorkDir))
+			return nil
 		}
+		for _, shard := range shards {
+			j, ok := index[shard.Path]
+			if !ok {
+				j = len(dirs)
+				index[shard.Path] = j
+				dirs = append(dirs, shard)
+				groups = append(groups, nil)
+			}
+			groups[j] = append(groups[j], i)
+		}
+	}
+
+	opts := C.disgorge_new_scan_options()
+	defer C.disgorge_del_scan_options(opts)
+	C.disgorge_scan_options_set_profile(opts, C.int(req.Profile))
 
-		items := scan(req.Query, startPrefix, endPrefix, shards[i], status[i])
-		resp.Data[i].Items = append(resp.Data[i].Items, items...)
-		count += len(items)
-		if count >= maxCount {
+	values := make([]string, len(req.Keys))
+	found := make([]bool, len(req.Keys))
+	count := 0
+	for j := 0; j < len(dirs); j++ {
+		if ctx.Err() != nil {
 			break
 		}
+		// skip the keys another host already had
+		pending := make([]int, 0, len(groups[j]))
+		for _, i := range groups[j] {
+			if !found[i] {
+				pending = append(pending, i)
+			}
+		}
+		if len(pending) == 0 {
+			continue
+		}
+		keys := make([]string, len(pending))
+		for k, i := range pending {
+			keys[k] = req.Keys[i]
+		}
+		vs, ok := multiget(dirs[j], keys, opts)
+		for k := 0; k < len(ok); k++ {
+			if ok[k] {
+				values[pending[k]] = vs[k]
+				found[pending[k]] = true
+				count++
+			}
+		}
 	}
 	stat.SetCounter(count)
-	return resp
+	return &api.MultiGetResponse{Code: 200, Values: values, Found: found}
+}
+
+// maxSetBytes is the most the values of a string set may take, libdisgorge
+// keeps their offsets in 32 bits
+const maxSetBytes = 1<<32 - 1
+
+// CreateSet uploads a set of ids, string values or integers, which queries
+// reference by the returned handle: `{"type": 18, "set": <handle>, ...}`.
+// Handles are local to this process and stay valid until DropSet; a string
+// set over maxSetBytes is refused with 413.
+func CreateSet(ctx context.Context, req *api.SetRequest) *api.SetResponse {
+	stat := prome.NewStat("warehouse.CreateSet")
+	defer stat.End()
+
+	var set C.ulonglong
+	if len(req.Ints) > 0 {
+		set = C.disgorge_new_int_set((*C.longlong)(unsafe.Pointer(&req.Ints[0])), C.ulonglong(len(req.Ints)))
+	} else {
+		buf, offs := packKeys(req.Values)
+		if offs[len(req.Values)] > maxSetBytes {
+			stat.MarkErr()
+			return &api.SetResponse{Code: 413}
+		}
+		set = C.disgorge_new_set(unsafe.Pointer(&buf[0]), &offs[0], C.ulonglong(len(req.Values)))
+	}
+	if set == 0 {
+		stat.MarkErr()
+		return &api.SetResponse{Code: 500}
+	}
+	stat.SetCounter(len(req.Values) + len(req.Ints))
+	return &api.SetResponse{Code: 200, Set: uint64(set)}
+}
+
+// DropSet releases a set, the scans still using it keep it until they end
+func DropSet(ctx context.Context, req *api.DropSetRequest) *api.SetResponse {
+	C.disgorge_del_set(C.ulonglong(req.Set))
+	return &api.SetResponse{Code: 200, Set: req.Set}
 }